@@ -0,0 +1,144 @@
+/**
+ *
+ * File name:           frame.c
+ * File description:    File containing the methods for the decoding of the
+ *                      firmware binary telemetry frames.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "frame.h"
+
+/* CRC-16/CCITT-FALSE */
+#define FRAME_CRC_POLYNOMIAL        0x1021U
+#define FRAME_CRC_INIT              0xFFFFU
+/* COBS code of a full block, not followed by a zero */
+#define FRAME_COBS_FULL_BLOCK       0xFF
+
+/**
+ * Method name:         frame_crc16
+ * Method description:  Computes the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer
+ * Input params:        pucData = Buffer
+ *                      uiLength = Buffer length in bytes
+ * Output params:       uint16_t = CRC
+ */
+uint16_t frame_crc16(const uint8_t *pucData, size_t uiLength)
+{
+    uint16_t uiCrc = FRAME_CRC_INIT;
+    int iBit;
+
+    while(uiLength--)
+    {
+        uiCrc ^= (uint16_t)(*pucData++ << 8);
+        for(iBit = 0; iBit < 8; iBit++)
+            uiCrc = (uiCrc & 0x8000) ? (uint16_t)((uiCrc << 1) ^ FRAME_CRC_POLYNOMIAL) : (uint16_t)(uiCrc << 1);
+    }
+    return uiCrc;
+}
+
+/**
+ * Method name:         frame_cobsDecode
+ * Method description:  Decodes a Consistent Overhead Byte Stuffing buffer, delimiter excluded
+ * Input params:        pucInput = Encoded buffer
+ *                      uiLength = Encoded length in bytes
+ *                      pucOutput = Decoded buffer
+ *                      uiOutputSize = Decoded buffer size in bytes
+ * Output params:       int = Decoded length, -1 if the buffer is not valid COBS or does not fit
+ */
+int frame_cobsDecode(const uint8_t *pucInput, size_t uiLength, uint8_t *pucOutput, size_t uiOutputSize)
+{
+    size_t uiIn = 0, uiOut = 0;
+    uint8_t ucCode, ucByte;
+
+    while(uiIn < uiLength)
+    {
+        /* Each block is its code and code - 1 data bytes, then a zero unless it is full or the last */
+        ucCode = pucInput[uiIn++];
+        if(!ucCode)
+            return -1;
+        for(ucByte = 1; ucByte < ucCode; ucByte++)
+        {
+            if((uiIn >= uiLength) || !pucInput[uiIn] || (uiOut >= uiOutputSize))
+                return -1;
+            pucOutput[uiOut++] = pucInput[uiIn++];
+        }
+        if((ucCode != FRAME_COBS_FULL_BLOCK) && (uiIn < uiLength))
+        {
+            if(uiOut >= uiOutputSize)
+                return -1;
+            pucOutput[uiOut++] = 0;
+        }
+    }
+    return (int)uiOut;
+}
+
+/**
+ * Method name:         frame_decode
+ * Method description:  Decodes one frame and checks its CRC
+ * Input params:        pucFrame = Encoded frame, delimiter excluded
+ *                      uiLength = Encoded length in bytes
+ *                      sample = t_FRAME_Sample struct, filled on success
+ * Output params:       int = 0 on success, -1 on a bad length, encoding or CRC
+ */
+int frame_decode(const uint8_t *pucFrame, size_t uiLength, t_FRAME_Sample *sample)
+{
+    uint8_t ucPayload[FRAME_PAYLOAD_SIZE];
+    uint16_t uiCrc;
+
+    if(FRAME_PAYLOAD_SIZE != frame_cobsDecode(pucFrame, uiLength, ucPayload, sizeof(ucPayload)))
+        return -1;
+    uiCrc = (uint16_t)(ucPayload[FRAME_PAYLOAD_SIZE - 2] | (ucPayload[FRAME_PAYLOAD_SIZE - 1] << 8));
+    if(uiCrc != frame_crc16(ucPayload, FRAME_PAYLOAD_SIZE - 2))
+        return -1;
+
+    /* Little-endian fields in hundredths, see telemetry_buildFrame */
+    sample->uiSequence = ucPayload[0];
+    sample->dVelocity = (int16_t)(ucPayload[1] | (ucPayload[2] << 8))/100.0;
+    sample->dPosition = (int32_t)((uint32_t)ucPayload[3] | ((uint32_t)ucPayload[4] << 8) |
+            ((uint32_t)ucPayload[5] << 16) | ((uint32_t)ucPayload[6] << 24))/100.0;
+    sample->dActuator = (int16_t)(ucPayload[7] | (ucPayload[8] << 8))/100.0;
+
+    return 0;
+}
+
+/**
+ * Method name:         frame_read
+ * Method description:  Reads and decodes the next frame of a stream. Empty frames (repeated
+ *                      delimiters) are skipped.
+ * Input params:        pStream = Input stream
+ *                      sample = t_FRAME_Sample struct, filled on success
+ * Output params:       int = 1 on a sample, 0 at the end of the stream, -1 on a bad frame
+ */
+int frame_read(FILE *pStream, t_FRAME_Sample *sample)
+{
+    uint8_t ucFrame[FRAME_ENCODED_SIZE];
+    size_t uiLength = 0;
+    int iByte, iOverrun = 0;
+
+    while(EOF != (iByte = getc(pStream)))
+    {
+        if(iByte)
+        {
+            /* Too long, keep reading up to the delimiter to resynchronize */
+            if(uiLength < sizeof(ucFrame))
+                ucFrame[uiLength++] = (uint8_t)iByte;
+            else
+                iOverrun = 1;
+            continue;
+        }
+        if(iOverrun)
+            return -1;
+        if(uiLength)
+            return frame_decode(ucFrame, uiLength, sample) ? -1 : 1;
+    }
+
+    /* A frame cut by the end of the recording */
+    return (uiLength || iOverrun) ? -1 : 0;
+}
@@ -0,0 +1,97 @@
+/**
+ *
+ * File name:           frame.h
+ * File description:    File containing the definition of methods for the
+ *                      decoding of the firmware binary telemetry frames,
+ *                      the host side of hal/telemetry ('t1' command).
+ *
+ *                      - A frame is a COBS encoded payload terminated by a
+ *                        0x00 byte. The payload is the sequence number,
+ *                        velocity, position and actuator fields and their
+ *                        CRC-16/CCITT-FALSE, little-endian, see telemetry.h
+ *                        in the firmware.
+ *                      - The reader resynchronizes on the next 0x00, so host
+ *                        reports or line noise between frames cost only the
+ *                        frame they run into.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SYSID_FRAME_H_
+#define SYSID_FRAME_H_
+
+/* System includes */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* TELEMETRY_PAYLOAD_SIZE of the firmware: fields plus CRC */
+#define FRAME_PAYLOAD_SIZE          11
+/* Encoded payload, without the 0x00 delimiter */
+#define FRAME_ENCODED_SIZE          (FRAME_PAYLOAD_SIZE + 1)
+/* The sequence number is one byte */
+#define FRAME_SEQUENCE_MASK         0xFFU
+
+/**
+ * Type name:           t_FRAME_Sample
+ * Method description:  Struct containing one decoded telemetry sample
+ * Params:              uiSequence:             Telemetry period of the sample, wraps at 255
+ *                      dVelocity:              Velocity, rad/s
+ *                      dPosition:              Position, degrees
+ *                      dActuator:              Actuator, percent
+ */
+typedef struct
+{
+    unsigned int uiSequence;
+    double dVelocity;
+    double dPosition;
+    double dActuator;
+} t_FRAME_Sample;
+
+/**
+ * Method name:         frame_crc16
+ * Method description:  Computes the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer
+ * Input params:        pucData = Buffer
+ *                      uiLength = Buffer length in bytes
+ * Output params:       uint16_t = CRC
+ */
+uint16_t frame_crc16(const uint8_t *pucData, size_t uiLength);
+
+/**
+ * Method name:         frame_cobsDecode
+ * Method description:  Decodes a Consistent Overhead Byte Stuffing buffer, delimiter excluded
+ * Input params:        pucInput = Encoded buffer
+ *                      uiLength = Encoded length in bytes
+ *                      pucOutput = Decoded buffer
+ *                      uiOutputSize = Decoded buffer size in bytes
+ * Output params:       int = Decoded length, -1 if the buffer is not valid COBS or does not fit
+ */
+int frame_cobsDecode(const uint8_t *pucInput, size_t uiLength, uint8_t *pucOutput, size_t uiOutputSize);
+
+/**
+ * Method name:         frame_decode
+ * Method description:  Decodes one frame and checks its CRC
+ * Input params:        pucFrame = Encoded frame, delimiter excluded
+ *                      uiLength = Encoded length in bytes
+ *                      sample = t_FRAME_Sample struct, filled on success
+ * Output params:       int = 0 on success, -1 on a bad length, encoding or CRC
+ */
+int frame_decode(const uint8_t *pucFrame, size_t uiLength, t_FRAME_Sample *sample);
+
+/**
+ * Method name:         frame_read
+ * Method description:  Reads and decodes the next frame of a stream. Empty frames (repeated
+ *                      delimiters) are skipped.
+ * Input params:        pStream = Input stream
+ *                      sample = t_FRAME_Sample struct, filled on success
+ * Output params:       int = 1 on a sample, 0 at the end of the stream, -1 on a bad frame
+ */
+int frame_read(FILE *pStream, t_FRAME_Sample *sample);
+
+#endif /* SYSID_FRAME_H_ */
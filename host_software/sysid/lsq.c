@@ -0,0 +1,142 @@
+/**
+ *
+ * File name:           lsq.c
+ * File description:    File containing the methods for the recursive
+ *                      accumulation and solution of linear least squares
+ *                      problems.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <math.h>
+#include <string.h>
+
+/* Project includes */
+#include "lsq.h"
+
+/* Pivots below this, relative to the scaled diagonal of 1, mean dependent regressors */
+#define LSQ_MIN_PIVOT               1e-10
+
+/**
+ * Method name:         lsq_init
+ * Method description:  Clears the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      iParameters = Number of regressors, up to LSQ_MAX_PARAMETERS
+ * Output params:       n/a
+ */
+void lsq_init(t_LSQ_Data *lsq, int iParameters)
+{
+    memset(lsq, 0, sizeof(*lsq));
+    lsq->iParameters = (iParameters > LSQ_MAX_PARAMETERS) ? LSQ_MAX_PARAMETERS : iParameters;
+}
+
+/**
+ * Method name:         lsq_addRow
+ * Method description:  Folds one observation into the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      pdX = Regressors, iParameters values
+ *                      dY = Observation
+ * Output params:       n/a
+ */
+void lsq_addRow(t_LSQ_Data *lsq, const double *pdX, double dY)
+{
+    int i, j;
+
+    for(i = 0; i < lsq->iParameters; i++)
+    {
+        for(j = i; j < lsq->iParameters; j++)
+            lsq->dXtX[i][j] += pdX[i]*pdX[j];
+        lsq->dXty[i] += pdX[i]*dY;
+    }
+    lsq->dYty += dY*dY;
+    lsq->dSumY += dY;
+    lsq->llRows++;
+}
+
+/**
+ * Method name:         lsq_solve
+ * Method description:  Solves the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      result = t_LSQ_Result struct, filled on success
+ * Output params:       int = 0 on success, -1 if there are too few rows or the
+ *                      regressors are not independent (no excitation)
+ */
+int lsq_solve(const t_LSQ_Data *lsq, t_LSQ_Result *result)
+{
+    double dA[LSQ_MAX_PARAMETERS][LSQ_MAX_PARAMETERS + 1];
+    double dScale[LSQ_MAX_PARAMETERS];
+    double dSse, dSst, dTemp;
+    int n = lsq->iParameters;
+    int i, j, k, iPivot;
+
+    if(lsq->llRows <= n)
+        return -1;
+
+    /* Unit diagonal: velocities, duties and signs have very different magnitudes */
+    for(i = 0; i < n; i++)
+    {
+        if(lsq->dXtX[i][i] <= 0)
+            return -1;
+        dScale[i] = 1/sqrt(lsq->dXtX[i][i]);
+    }
+    for(i = 0; i < n; i++)
+    {
+        for(j = 0; j < n; j++)
+            dA[i][j] = ((i <= j) ? lsq->dXtX[i][j] : lsq->dXtX[j][i])*dScale[i]*dScale[j];
+        dA[i][n] = lsq->dXty[i]*dScale[i];
+    }
+
+    /* Gaussian elimination with partial pivoting */
+    for(k = 0; k < n; k++)
+    {
+        iPivot = k;
+        for(i = k + 1; i < n; i++)
+            if(fabs(dA[i][k]) > fabs(dA[iPivot][k]))
+                iPivot = i;
+        if(fabs(dA[iPivot][k]) < LSQ_MIN_PIVOT)
+            return -1;
+        if(iPivot != k)
+        {
+            for(j = k; j <= n; j++)
+            {
+                dTemp = dA[k][j];
+                dA[k][j] = dA[iPivot][j];
+                dA[iPivot][j] = dTemp;
+            }
+        }
+        for(i = k + 1; i < n; i++)
+        {
+            dTemp = dA[i][k]/dA[k][k];
+            for(j = k; j <= n; j++)
+                dA[i][j] -= dTemp*dA[k][j];
+        }
+    }
+    for(i = n - 1; i >= 0; i--)
+    {
+        dTemp = dA[i][n];
+        for(j = i + 1; j < n; j++)
+            dTemp -= dA[i][j]*result->dTheta[j];
+        result->dTheta[i] = dTemp/dA[i][i];
+    }
+    for(i = 0; i < n; i++)
+        result->dTheta[i] *= dScale[i];
+
+    /* Residual from the sums: e'e = y'y - 2*theta'X'y + theta'X'X*theta = y'y - theta'X'y at the optimum */
+    dSse = lsq->dYty;
+    for(i = 0; i < n; i++)
+        dSse -= result->dTheta[i]*lsq->dXty[i];
+    if(dSse < 0)
+        dSse = 0;
+    dSst = lsq->dYty - lsq->dSumY*lsq->dSumY/lsq->llRows;
+    result->dRms = sqrt(dSse/lsq->llRows);
+    result->dRsquared = (dSst > 0) ? 1 - dSse/dSst : 0;
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+/**
+ *
+ * File name:           lsq.h
+ * File description:    File containing the definition of methods for the
+ *                      recursive accumulation and solution of linear least
+ *                      squares problems.
+ *
+ *                      - Rows are folded into the normal equations as they
+ *                        arrive, so memory does not grow with the recording
+ *                        and each row costs n*(n+1)/2 multiply-adds.
+ *                      - The solution scales the columns and eliminates
+ *                        with partial pivoting, enough for the few
+ *                        regressors of a motor model.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SYSID_LSQ_H_
+#define SYSID_LSQ_H_
+
+/* Maximum number of regressors */
+#define LSQ_MAX_PARAMETERS          6
+
+/**
+ * Type name:           t_LSQ_Data
+ * Method description:  Struct containing the normal equations of a least squares problem
+ * Params:              iParameters:            Number of regressors
+ *                      llRows:                 Rows accumulated
+ *                      dXtX:                   Upper triangle of X'X
+ *                      dXty:                   X'y
+ *                      dYty:                   y'y, for the residual
+ *                      dSumY:                  Sum of y, for the coefficient of determination
+ */
+typedef struct
+{
+    int iParameters;
+    long long llRows;
+    double dXtX[LSQ_MAX_PARAMETERS][LSQ_MAX_PARAMETERS];
+    double dXty[LSQ_MAX_PARAMETERS];
+    double dYty;
+    double dSumY;
+} t_LSQ_Data;
+
+/**
+ * Type name:           t_LSQ_Result
+ * Method description:  Struct containing a least squares solution
+ * Params:              dTheta:                 Parameters
+ *                      dRms:                   Root mean square residual
+ *                      dRsquared:              Coefficient of determination, against the mean of y
+ */
+typedef struct
+{
+    double dTheta[LSQ_MAX_PARAMETERS];
+    double dRms;
+    double dRsquared;
+} t_LSQ_Result;
+
+/**
+ * Method name:         lsq_init
+ * Method description:  Clears the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      iParameters = Number of regressors, up to LSQ_MAX_PARAMETERS
+ * Output params:       n/a
+ */
+void lsq_init(t_LSQ_Data *lsq, int iParameters);
+
+/**
+ * Method name:         lsq_addRow
+ * Method description:  Folds one observation into the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      pdX = Regressors, iParameters values
+ *                      dY = Observation
+ * Output params:       n/a
+ */
+void lsq_addRow(t_LSQ_Data *lsq, const double *pdX, double dY);
+
+/**
+ * Method name:         lsq_solve
+ * Method description:  Solves the normal equations
+ * Input params:        lsq = t_LSQ_Data struct
+ *                      result = t_LSQ_Result struct, filled on success
+ * Output params:       int = 0 on success, -1 if there are too few rows or the
+ *                      regressors are not independent (no excitation)
+ */
+int lsq_solve(const t_LSQ_Data *lsq, t_LSQ_Result *result);
+
+#endif /* SYSID_LSQ_H_ */
@@ -0,0 +1,511 @@
+/**
+ *
+ * File name:           sysid.c
+ * File description:    Offline identification of the DC motor from recorded
+ *                      firmware telemetry.
+ *
+ *                      - Reads the text telemetry, one "velocity position
+ *                        actuator" line per period (rad/s, degrees, duty
+ *                        percent), from files or the standard input. Lines
+ *                        starting with '#' are host reports and are skipped.
+ *                        With -b it reads the binary frames ('t1' command)
+ *                        instead, see frame.h.
+ *                      - The fit needs consecutive periods. Text lines carry
+ *                        no period number, so a line the firmware did not
+ *                        send (full TX buffer, 'o3' shedding) goes unseen
+ *                        and joins two periods apart. Frames carry one, and
+ *                        a gap in it restarts the history: record with 't1'
+ *                        and -b whenever telemetry may be lost.
+ *                      - Fits by least squares the discrete models, with
+ *                        the duty as voltage:
+ *                          1st: w[k+1] = a*w[k] + b*v[k] - c*sgn(w[k])
+ *                          2nd: w[k+1] = a1*w[k] + a2*w[k-1] + b1*v[k]
+ *                                        + b2*v[k-1] - c*sgn(w[k])
+ *                        streaming the rows into the normal equations, so
+ *                        hours of telemetry take seconds and no memory.
+ *                      - Prints the gain, time constants and friction, the
+ *                        feedforward constants in the units of the 'u', 's',
+ *                        'z' and 'y' host commands, and PID gains for both
+ *                        loop structures in the units of 'p', 'i' and 'd'.
+ *
+ *                      Usage: sysid [options] [file...]
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "frame.h"
+#include "lsq.h"
+
+/* Defaults, the firmware values: TELEMETRY_TASK_PERIOD, MOTOR_SUPPLY_MV and the resistance of */
+/* FEEDFORWARD_SET_NOMINAL */
+#define SYSID_DEFAULT_PERIOD_MS         20
+#define SYSID_DEFAULT_SUPPLY_MV         12000
+#define SYSID_DEFAULT_RESISTANCE_MOHM   2500
+/* Closed-loop time constant of the suggested PID gains, ms */
+#define SYSID_DEFAULT_LAMBDA_MS         40
+/* Velocity loop PID output to duty: percent = output*100/MAX_MOTOR_VELOCITY_RAD */
+#define SYSID_MAX_MOTOR_VELOCITY_RAD    (2100*2*3.14159/60)
+/* The 'p', 'i' and 'd' host commands carry the gains times this */
+#define SYSID_GAIN_SCALE                10000
+/* Velocities within this band are rest for the friction sign, about one encoder count per period, rad/s */
+#define SYSID_VELOCITY_DEADBAND         0.5
+/* Read buffer of the input streams */
+#define SYSID_READ_BUFFER_SIZE          (1 << 20)
+
+/* Regressors of the models */
+#define SYSID_FIRST_ORDER_PARAMETERS    3
+#define SYSID_SECOND_ORDER_PARAMETERS   5
+
+/**
+ * Type name:           t_SYSID_Options
+ * Method description:  Struct containing the command line options
+ * Params:              dPeriod:                Telemetry period, s
+ *                      dSupply:                H-bridge supply, V
+ *                      dResistance:            Winding and bridge resistance, Ohm
+ *                      dBackEmf:               Known back-EMF constant, V per rad/s, 0 to derive it from the gain
+ *                      dLambda:                Closed-loop time constant of the suggested PID gains, s
+ *                      iSecondOrder:           Also fit the second-order model
+ *                      iBinary:                Binary telemetry frames instead of text
+ */
+typedef struct
+{
+    double dPeriod;
+    double dSupply;
+    double dResistance;
+    double dBackEmf;
+    double dLambda;
+    int iSecondOrder;
+    int iBinary;
+} t_SYSID_Options;
+
+/**
+ * Type name:           t_SYSID_Data
+ * Method description:  Struct containing the sample history and the normal equations of both models
+ * Params:              iHistory:               Consecutive samples held, up to 2
+ *                      dVelocity:              Velocity of the last two samples, rad/s, [0] newest
+ *                      dVoltage:               Voltage of the last two samples, V, [0] newest
+ *                      llSamples:              Telemetry lines read
+ *                      llSkipped:              Malformed lines or bad frames, each breaks the sample history
+ *                      llLost:                 Periods missing from the frame sequence, bad frames included
+ *                      iSequenceValid:         uiSequence holds the previous frame of this recording
+ *                      uiSequence:             Sequence number of the previous frame
+ *                      tFirstOrder:            Normal equations of the first-order model
+ *                      tSecondOrder:           Normal equations of the second-order model
+ */
+typedef struct
+{
+    int iHistory;
+    double dVelocity[2];
+    double dVoltage[2];
+    long long llSamples;
+    long long llSkipped;
+    long long llLost;
+    int iSequenceValid;
+    unsigned int uiSequence;
+    t_LSQ_Data tFirstOrder;
+    t_LSQ_Data tSecondOrder;
+} t_SYSID_Data;
+
+/**
+ * Method name:         sysid_usage
+ * Method description:  Prints the command line help
+ * Input params:        pcName = Program name
+ * Output params:       n/a
+ */
+static void sysid_usage(const char *pcName)
+{
+    fprintf(stderr,
+            "Usage: %s [options] [file...]\n"
+            "Fits a DC motor model to text telemetry (\"velocity position actuator\" lines)\n"
+            "or binary frames (-b), read from the files or the standard input.\n"
+            "  -t <ms>      telemetry period, default %d ('e' command)\n"
+            "  -V <mV>      H-bridge supply, default %d\n"
+            "  -R <mOhm>    winding and bridge resistance, default %d\n"
+            "  -k <uV>      known back-EMF constant per rad/s, default from the gain\n"
+            "  -l <ms>      closed-loop time constant of the PID gains, default %d\n"
+            "  -2           also fit a second-order model\n"
+            "  -b           binary telemetry frames ('t1' command) instead of text, their\n"
+            "               sequence numbers catch the periods the firmware did not send\n",
+            pcName, SYSID_DEFAULT_PERIOD_MS, SYSID_DEFAULT_SUPPLY_MV, SYSID_DEFAULT_RESISTANCE_MOHM,
+            SYSID_DEFAULT_LAMBDA_MS);
+}
+
+/**
+ * Method name:         sysid_sign
+ * Method description:  Direction of the friction torque
+ * Input params:        dVelocity = Velocity, rad/s
+ * Output params:       double = 1, -1, or 0 at rest
+ */
+static double sysid_sign(double dVelocity)
+{
+    if(dVelocity > SYSID_VELOCITY_DEADBAND)
+        return 1;
+    if(dVelocity < -SYSID_VELOCITY_DEADBAND)
+        return -1;
+    return 0;
+}
+
+/**
+ * Method name:         sysid_addSample
+ * Method description:  Adds one telemetry sample: the rows predicting it from the history
+ *                      go into the normal equations. Rows at rest with no voltage carry
+ *                      no information and are left out, they are most of an idle log.
+ * Input params:        sysid = t_SYSID_Data struct
+ *                      dVelocity = Velocity, rad/s
+ *                      dVoltage = Voltage, V
+ * Output params:       n/a
+ */
+static void sysid_addSample(t_SYSID_Data *sysid, double dVelocity, double dVoltage)
+{
+    double dX[SYSID_SECOND_ORDER_PARAMETERS];
+    int iAtRest;
+
+    iAtRest = (0 == sysid_sign(dVelocity)) && (0 == sysid_sign(sysid->dVelocity[0])) && (0 == sysid->dVoltage[0]);
+    if((sysid->iHistory >= 1) && !iAtRest)
+    {
+        dX[0] = sysid->dVelocity[0];
+        dX[1] = sysid->dVoltage[0];
+        dX[2] = -sysid_sign(sysid->dVelocity[0]);
+        lsq_addRow(&sysid->tFirstOrder, dX, dVelocity);
+    }
+    if((sysid->iHistory >= 2) && !iAtRest)
+    {
+        dX[0] = sysid->dVelocity[0];
+        dX[1] = sysid->dVelocity[1];
+        dX[2] = sysid->dVoltage[0];
+        dX[3] = sysid->dVoltage[1];
+        dX[4] = -sysid_sign(sysid->dVelocity[0]);
+        lsq_addRow(&sysid->tSecondOrder, dX, dVelocity);
+    }
+
+    sysid->dVelocity[1] = sysid->dVelocity[0];
+    sysid->dVoltage[1] = sysid->dVoltage[0];
+    sysid->dVelocity[0] = dVelocity;
+    sysid->dVoltage[0] = dVoltage;
+    if(sysid->iHistory < 2)
+        sysid->iHistory++;
+    sysid->llSamples++;
+}
+
+/**
+ * Method name:         sysid_readStream
+ * Method description:  Parses a telemetry stream into the normal equations
+ * Input params:        sysid = t_SYSID_Data struct
+ *                      pStream = Input stream
+ *                      options = Command line options
+ * Output params:       n/a
+ */
+static void sysid_readStream(t_SYSID_Data *sysid, FILE *pStream, const t_SYSID_Options *options)
+{
+    char cLine[256];
+    char *pcCursor, *pcEnd;
+    double dVelocity, dActuator;
+
+    setvbuf(pStream, NULL, _IOFBF, SYSID_READ_BUFFER_SIZE);
+    while(fgets(cLine, sizeof(cLine), pStream))
+    {
+        pcCursor = cLine;
+        while((' ' == *pcCursor) || ('\t' == *pcCursor))
+            pcCursor++;
+        /* Host reports and blank lines do not break the history, the telemetry goes on around them */
+        if(('#' == *pcCursor) || ('\r' == *pcCursor) || ('\n' == *pcCursor) || ('\0' == *pcCursor))
+            continue;
+
+        dVelocity = strtod(pcCursor, &pcEnd);
+        if(pcEnd != pcCursor)
+        {
+            /* The position is not used */
+            pcCursor = pcEnd;
+            strtod(pcCursor, &pcEnd);
+        }
+        if(pcEnd != pcCursor)
+        {
+            pcCursor = pcEnd;
+            dActuator = strtod(pcCursor, &pcEnd);
+        }
+        if(pcEnd == pcCursor)
+        {
+            /* A lost or garbled line, the next sample does not follow the last one */
+            sysid->iHistory = 0;
+            sysid->llSkipped++;
+            continue;
+        }
+
+        sysid_addSample(sysid, dVelocity, dActuator*options->dSupply/100);
+    }
+}
+
+/**
+ * Method name:         sysid_readFrames
+ * Method description:  Parses a binary telemetry stream into the normal equations
+ * Input params:        sysid = t_SYSID_Data struct
+ *                      pStream = Input stream
+ *                      options = Command line options
+ * Output params:       n/a
+ */
+static void sysid_readFrames(t_SYSID_Data *sysid, FILE *pStream, const t_SYSID_Options *options)
+{
+    t_FRAME_Sample sample;
+    unsigned int uiGap;
+    int iResult;
+
+    setvbuf(pStream, NULL, _IOFBF, SYSID_READ_BUFFER_SIZE);
+    while(0 != (iResult = frame_read(pStream, &sample)))
+    {
+        if(iResult < 0)
+        {
+            /* A garbled frame, or host reports in between: the next sample does not follow the last one */
+            sysid->iHistory = 0;
+            sysid->llSkipped++;
+            continue;
+        }
+        /* Dropped, shed or garbled periods: the sample does not follow the last one.
+         * A loss of a multiple of 256 periods goes unseen */
+        uiGap = (sample.uiSequence - sysid->uiSequence) & FRAME_SEQUENCE_MASK;
+        if(sysid->iSequenceValid && (1 != uiGap))
+        {
+            sysid->iHistory = 0;
+            sysid->llLost += (uiGap ? uiGap : FRAME_SEQUENCE_MASK + 1) - 1;
+        }
+        sysid->iSequenceValid = 1;
+        sysid->uiSequence = sample.uiSequence;
+        sysid_addSample(sysid, sample.dVelocity, sample.dActuator*options->dSupply/100);
+    }
+}
+
+/**
+ * Method name:         sysid_printFirstOrder
+ * Method description:  Prints the first-order model, the motor constants and the firmware settings
+ * Input params:        fit = First-order solution
+ *                      options = Command line options
+ * Output params:       int = 0, -1 if the model is not a stable first-order lag
+ */
+static int sysid_printFirstOrder(const t_LSQ_Result *fit, const t_SYSID_Options *options)
+{
+    double a = fit->dTheta[0], b = fit->dTheta[1], c = fit->dTheta[2];
+    double dTau, dGain, dFriction, dBackEmf, dStatic, dViscous, dInertia;
+    double dDelay = options->dPeriod, dKp, dKi, dTi, dPlantGain;
+
+    printf("first order     w[k+1] = %.6f*w[k] + %.6f*v[k] - %.6f*sgn(w[k])\n", a, b, c);
+    printf("  fit           rms %.4f rad/s, r2 %.6f\n", fit->dRms, fit->dRsquared);
+    if((a <= 0) || (a >= 1) || (b <= 0))
+    {
+        fprintf(stderr, "sysid: not a stable first-order response, check the period and the excitation\n");
+        return -1;
+    }
+
+    /* Continuous model: tau*dw/dt = -w + K*(v - V0*sgn(w)) */
+    dTau = -options->dPeriod/log(a);
+    dGain = b/(1 - a);
+    dFriction = c/b;
+    printf("  gain          %.4f rad/s per V\n", dGain);
+    printf("  time constant %.2f ms\n", 1000*dTau);
+    printf("  friction      %.4f V\n", dFriction);
+
+    /* DC motor, Kt = Ke: 1/K = Ke + R*b/Kt and tau = J*R/(Kt*Ke + R*b). The friction and inertia */
+    /* currents do not depend on how 1/K splits between back-EMF and viscous friction */
+    dBackEmf = (options->dBackEmf > 0) ? options->dBackEmf : 1/dGain;
+    dStatic = dFriction/options->dResistance;
+    dViscous = (1/dGain - dBackEmf)/options->dResistance;
+    if(dViscous < 0)
+        dViscous = 0;
+    dInertia = dTau/(dGain*options->dResistance);
+    printf("  back-EMF      %.5f V per rad/s%s\n", dBackEmf, (options->dBackEmf > 0) ? " (given)" : " (1/gain, no viscous friction)");
+    printf("  inertia       %.3e kg*m^2\n", dInertia*dBackEmf);
+    printf("feedforward     u%.0f s%.0f z%.0f y%.0f\n", 1e6*dStatic, 1e6*dViscous, 1e6*dInertia, 1e6*dBackEmf);
+
+    /* SIMC PI rules, one period of delay: the velocity loop drives the duty, a first-order lag; */
+    /* the cascade loop drives the current, an integrator once the current loop removes the back-EMF */
+    dPlantGain = dGain*options->dSupply/SYSID_MAX_MOTOR_VELOCITY_RAD;
+    dKp = dTau/(dPlantGain*(options->dLambda + dDelay));
+    dTi = fmin(dTau, 4*(options->dLambda + dDelay));
+    dKi = dKp*options->dPeriod/dTi;
+    printf("velocity loop   p%.0f i%.0f d0\n", SYSID_GAIN_SCALE*dKp, SYSID_GAIN_SCALE*dKi);
+    dKp = dInertia/(options->dLambda + dDelay);
+    dTi = 4*(options->dLambda + dDelay);
+    dKi = dKp*options->dPeriod/dTi;
+    printf("cascade loop    p%.0f i%.0f d0\n", SYSID_GAIN_SCALE*dKp, SYSID_GAIN_SCALE*dKi);
+
+    return 0;
+}
+
+/**
+ * Method name:         sysid_printSecondOrder
+ * Method description:  Prints the second-order model with its poles
+ * Input params:        fit = Second-order solution
+ *                      options = Command line options
+ * Output params:       n/a
+ */
+static void sysid_printSecondOrder(const t_LSQ_Result *fit, const t_SYSID_Options *options)
+{
+    double a1 = fit->dTheta[0], a2 = fit->dTheta[1], b1 = fit->dTheta[2], b2 = fit->dTheta[3], c = fit->dTheta[4];
+    double complex z[2], s[2], dSum, dProduct, dRoot;
+    double dTauSum, dTauProduct, dNatural;
+    int i;
+
+    printf("second order    w[k+1] = %.6f*w[k] + %.6f*w[k-1] + %.6f*v[k] + %.6f*v[k-1] - %.6f*sgn(w[k])\n",
+            a1, a2, b1, b2, c);
+    printf("  fit           rms %.4f rad/s, r2 %.6f\n", fit->dRms, fit->dRsquared);
+    if((1 - a1 - a2) != 0)
+        printf("  gain          %.4f rad/s per V\n", (b1 + b2)/(1 - a1 - a2));
+    if((b1 + b2) != 0)
+        printf("  friction      %.4f V\n", c/(b1 + b2));
+
+    /* Poles of z^2 - a1*z - a2 */
+    dRoot = csqrt(a1*a1 + 4*a2);
+    z[0] = (a1 + dRoot)/2;
+    z[1] = (a1 - dRoot)/2;
+    if(cimag(z[0]) == 0)
+        printf("  poles         z = %.5f, %.5f\n", creal(z[0]), creal(z[1]));
+    else
+        printf("  poles         z = %.5f%+.5fi, %.5f%+.5fi\n", creal(z[0]), cimag(z[0]), creal(z[1]), cimag(z[1]));
+    for(i = 0; i < 2; i++)
+    {
+        if(cabs(z[i]) >= 1)
+        {
+            printf("  unstable pole, no continuous model\n");
+            return;
+        }
+        if((cimag(z[i]) == 0) && (creal(z[i]) <= 0))
+        {
+            printf("  pole on the negative axis, faster than the period can show: sample faster or use the first order\n");
+            return;
+        }
+        s[i] = clog(z[i])/options->dPeriod;
+    }
+
+    /* (s - s0)*(s - s1) = s^2 - S*s + P, as tau1*tau2*s^2 + (tau1 + tau2)*s + 1 */
+    dSum = s[0] + s[1];
+    dProduct = s[0]*s[1];
+    dTauSum = -creal(dSum)/creal(dProduct);
+    dTauProduct = 1/creal(dProduct);
+    if(cimag(s[0]) == 0)
+    {
+        printf("  time constants %.2f ms, %.2f ms\n", -1000/creal(s[0]), -1000/creal(s[1]));
+    }
+    else
+    {
+        dNatural = sqrt(creal(dProduct));
+        printf("  natural freq  %.3f rad/s, damping %.4f\n", dNatural, -creal(dSum)/(2*dNatural));
+    }
+    /* DC motor: tau1 + tau2 ~ J*R/(Kt*Ke), tau1*tau2 ~ L*J/(Kt*Ke). The fast pole also holds the lag */
+    /* of the velocity measurement, so the inductance is an upper bound */
+    printf("  mechanical    %.2f ms\n", 1000*dTauSum);
+    printf("  inductance    %.3f mH at most\n", 1000*options->dResistance*dTauProduct/dTauSum);
+}
+
+/**
+ * Method name:         main
+ * Method description:  Parses the options, reads the telemetry and prints the models
+ * Input params:        argc, argv = Command line
+ * Output params:       int = 0 on success, 1 on bad usage, unreadable input or no fit
+ */
+int main(int argc, char *argv[])
+{
+    t_SYSID_Options options = {
+        SYSID_DEFAULT_PERIOD_MS/1000.0, SYSID_DEFAULT_SUPPLY_MV/1000.0, SYSID_DEFAULT_RESISTANCE_MOHM/1000.0,
+        0, SYSID_DEFAULT_LAMBDA_MS/1000.0, 0, 0
+    };
+    static t_SYSID_Data sysid;
+    t_LSQ_Result fit;
+    FILE *pStream;
+    int iOption, i, iResult = 0;
+
+    while(-1 != (iOption = getopt(argc, argv, "t:V:R:k:l:2bh")))
+    {
+        switch(iOption)
+        {
+            case 't':
+                options.dPeriod = atof(optarg)/1000;
+                break;
+            case 'V':
+                options.dSupply = atof(optarg)/1000;
+                break;
+            case 'R':
+                options.dResistance = atof(optarg)/1000;
+                break;
+            case 'k':
+                options.dBackEmf = atof(optarg)/1e6;
+                break;
+            case 'l':
+                options.dLambda = atof(optarg)/1000;
+                break;
+            case '2':
+                options.iSecondOrder = 1;
+                break;
+            case 'b':
+                options.iBinary = 1;
+                break;
+            default:
+                sysid_usage(argv[0]);
+                return 1;
+        }
+    }
+    if((options.dPeriod <= 0) || (options.dSupply <= 0) || (options.dResistance <= 0) || (options.dLambda < 0))
+    {
+        sysid_usage(argv[0]);
+        return 1;
+    }
+
+    lsq_init(&sysid.tFirstOrder, SYSID_FIRST_ORDER_PARAMETERS);
+    lsq_init(&sysid.tSecondOrder, SYSID_SECOND_ORDER_PARAMETERS);
+    if(optind >= argc)
+    {
+        if(options.iBinary)
+            sysid_readFrames(&sysid, stdin, &options);
+        else
+            sysid_readStream(&sysid, stdin, &options);
+    }
+    for(i = optind; i < argc; i++)
+    {
+        if(NULL == (pStream = fopen(argv[i], options.iBinary ? "rb" : "r")))
+        {
+            perror(argv[i]);
+            return 1;
+        }
+        /* Each file is its own recording */
+        sysid.iHistory = 0;
+        sysid.iSequenceValid = 0;
+        if(options.iBinary)
+            sysid_readFrames(&sysid, pStream, &options);
+        else
+            sysid_readStream(&sysid, pStream, &options);
+        fclose(pStream);
+    }
+
+    printf("samples         %lld (%lld skipped, %lld fitted)\n", sysid.llSamples, sysid.llSkipped, sysid.tFirstOrder.llRows);
+    if(options.iBinary)
+        printf("lost periods    %lld\n", sysid.llLost);
+    if(0 != lsq_solve(&sysid.tFirstOrder, &fit))
+    {
+        fprintf(stderr, "sysid: no fit, the recording needs the motor running at changing references\n");
+        return 1;
+    }
+    if(0 != sysid_printFirstOrder(&fit, &options))
+        iResult = 1;
+
+    if(options.iSecondOrder)
+    {
+        if(0 != lsq_solve(&sysid.tSecondOrder, &fit))
+            fprintf(stderr, "sysid: no second-order fit, the regressors are not independent\n");
+        else
+            sysid_printSecondOrder(&fit, &options);
+    }
+
+    return iResult;
+}
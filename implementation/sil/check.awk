@@ -0,0 +1,68 @@
+#
+# File name:           check.awk
+# File description:    Pass/fail check of a --trace file of the SIL, run by
+#                      make check. Fails on a step response that is slower,
+#                      overshoots more or holds the reference worse than
+#                      the limits below.
+#
+#                      awk -F, [-v NAME=label] -f check.awk trace.csv
+#
+# Authors:             Bruno de Souza Ferreira
+#                      Guilherme Kairalla Kolotelo
+#                      Guilherme Bersi Pereira
+#
+# Creation date:       18Oct2026
+# Revision date:       18Oct2026
+#
+
+BEGIN {
+    # Firmware reference at power up, rad/s
+    REFERENCE = 40
+    # Settled: within BAND of the reference from SETTLE_TIME on, s
+    BAND = 2
+    SETTLE_TIME = 1.0
+    # Peak above the reference, rad/s
+    MAX_OVERSHOOT = 4
+    # Mean error over the last second, rad/s
+    MAX_MEAN_ERROR = 0.5
+    lastOutside = 0
+    peak = -1e9
+}
+
+# time,duty,current,velocity,angle
+NR > 1 {
+    time = $1
+    velocity = $4
+    if(velocity > peak)
+        peak = velocity
+    if((velocity > REFERENCE + BAND) || (velocity < REFERENCE - BAND))
+        lastOutside = time
+    samples[NR] = velocity
+    times[NR] = time
+    last = NR
+}
+
+END {
+    if(last < 2)
+    {
+        printf("%s: FAIL, empty trace\n", NAME)
+        exit 1
+    }
+    sum = 0
+    count = 0
+    for(i = 2; i <= last; i++)
+    {
+        if(times[i] > times[last] - 1)
+        {
+            sum += samples[i] - REFERENCE
+            count++
+        }
+    }
+    meanError = sum/count
+    fail = (lastOutside > SETTLE_TIME) || (peak - REFERENCE > MAX_OVERSHOOT) ||
+           (meanError > MAX_MEAN_ERROR) || (meanError < -MAX_MEAN_ERROR)
+    printf("%s: %s, settled at %.3fs (<= %.1f), overshoot %.2f (<= %d), mean error %.3f (<= %.1f) rad/s\n",
+           NAME, fail ? "FAIL" : "pass", lastOutside, SETTLE_TIME, peak - REFERENCE, MAX_OVERSHOOT,
+           meanError, MAX_MEAN_ERROR)
+    exit fail
+}
@@ -0,0 +1,21 @@
+/**
+ *
+ * File name:           MKL25Z4.h
+ * File description:    Software-in-the-loop stand-in for the target header
+ *                      of the same name. See sil_hw.h.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SIL_MKL25Z4_H_
+#define SIL_MKL25Z4_H_
+
+#include "sil_hw.h"
+
+#endif /* SIL_MKL25Z4_H_ */
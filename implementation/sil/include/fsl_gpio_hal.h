@@ -0,0 +1,21 @@
+/**
+ *
+ * File name:           fsl_gpio_hal.h
+ * File description:    Software-in-the-loop stand-in for the target header
+ *                      of the same name. See sil_hw.h.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SIL_FSL_GPIO_HAL_H_
+#define SIL_FSL_GPIO_HAL_H_
+
+#include "sil_hw.h"
+
+#endif /* SIL_FSL_GPIO_HAL_H_ */
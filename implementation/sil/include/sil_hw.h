@@ -0,0 +1,523 @@
+/**
+ *
+ * File name:           sil_hw.h
+ * File description:    File containing the simulated KL25Z peripherals used
+ *                      by the software-in-the-loop host build.
+ *
+ *                      - Replaces MKL25Z4.h, CMSIS and the KSDK headers the
+ *                        firmware includes, so sources/ compiles unchanged.
+ *                      - Registers are plain RAM structs. Reads that must
+ *                        reflect simulated hardware state (SysTick, UART
+ *                        data) go through functions.
+ *                      - Interrupt handlers are called from the simulation
+ *                        thread while holding the interrupt lock, which is
+ *                        also what __disable_irq() takes.
+ *                      - Entering a low power mode through the SMC HAL blocks
+ *                        the firmware until the next interrupt.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SIL_HW_H_
+#define SIL_HW_H_
+
+/* System includes */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/*                        Core                           */
+/* Simulated core clock, used to scale host time into SysTick counts */
+#define SIL_CORE_CLOCK_HZ               40000000U
+/* OSCERCLK, TPM clock source */
+#define SIL_OSCERCLK_HZ                 8000000U
+
+typedef enum
+{
+    DMA0_IRQn = 0, DMA1_IRQn, DMA2_IRQn, DMA3_IRQn, Reserved20_IRQn, FTFA_IRQn,
+    LVD_LVW_IRQn, LLW_IRQn, I2C0_IRQn, I2C1_IRQn, SPI0_IRQn, SPI1_IRQn,
+    UART0_IRQn, UART1_IRQn, UART2_IRQn, ADC0_IRQn, CMP0_IRQn, TPM0_IRQn,
+    TPM1_IRQn, TPM2_IRQn, RTC_IRQn, RTC_Seconds_IRQn, PIT_IRQn, Reserved39_IRQn,
+    USB0_IRQn, DAC0_IRQn, TSI0_IRQn, MCG_IRQn, LPTMR0_IRQn, Reserved45_IRQn,
+    PORTA_IRQn, PORTD_IRQn, SIL_IRQ_COUNT
+} IRQn_Type;
+
+void NVIC_EnableIRQ(IRQn_Type tIrq);
+void NVIC_DisableIRQ(IRQn_Type tIrq);
+void NVIC_SetPriority(IRQn_Type tIrq, uint32_t uiPriority);
+void __disable_irq(void);
+void __enable_irq(void);
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t uiPriMask);
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} SysTick_Type;
+
+#define SysTick_CTRL_ENABLE_Msk         (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk        (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk      (1UL << 2)
+#define SysTick_LOAD_RELOAD_Msk         0xFFFFFFUL
+/* Every access refreshes VAL from the host clock */
+SysTick_Type *sil_sysTick(void);
+#define SysTick                         (sil_sysTick())
+
+/*                        Ports                          */
+#define PORTA_IDX                       0U
+#define PORTB_IDX                       1U
+#define PORTC_IDX                       2U
+#define PORTD_IDX                       3U
+#define PORTE_IDX                       4U
+
+typedef struct
+{
+    volatile uint32_t PCR[32];
+    volatile uint32_t ISFR;
+} PORT_Type;
+
+typedef struct
+{
+    volatile uint32_t PDOR;
+    volatile uint32_t PSOR;
+    volatile uint32_t PCOR;
+    volatile uint32_t PTOR;
+    volatile uint32_t PDIR;
+    volatile uint32_t PDDR;
+} GPIO_Type;
+
+extern PORT_Type sil_port[5];
+extern GPIO_Type sil_gpio[5];
+#define PORTA                           (&sil_port[PORTA_IDX])
+#define PORTB                           (&sil_port[PORTB_IDX])
+#define PORTC                           (&sil_port[PORTC_IDX])
+#define PORTD                           (&sil_port[PORTD_IDX])
+#define PORTE                           (&sil_port[PORTE_IDX])
+#define GPIOA                           (&sil_gpio[PORTA_IDX])
+#define GPIOB                           (&sil_gpio[PORTB_IDX])
+#define GPIOC                           (&sil_gpio[PORTC_IDX])
+#define GPIOD                           (&sil_gpio[PORTD_IDX])
+#define GPIOE                           (&sil_gpio[PORTE_IDX])
+#define PTA                             GPIOA
+#define PTB                             GPIOB
+#define PTC                             GPIOC
+#define PTD                             GPIOD
+#define PTE                             GPIOE
+#define PTB_BASE_PTR                    GPIOB
+
+typedef enum
+{
+    kPortPinDisabled = 0, kPortMuxAsGpio, kPortMuxAlt2, kPortMuxAlt3,
+    kPortMuxAlt4, kPortMuxAlt5, kPortMuxAlt6, kPortMuxAlt7
+} port_mux_t;
+
+typedef enum
+{
+    kPortIntDisabled = 0x0, kPortIntLogicZero = 0x8, kPortIntRisingEdge = 0x9,
+    kPortIntFallingEdge = 0xA, kPortIntEitherEdge = 0xB, kPortIntLogicOne = 0xC
+} port_interrupt_config_t;
+
+typedef enum
+{
+    kGpioDigitalInput = 0, kGpioDigitalOutput
+} gpio_pin_direction_t;
+
+void PORT_HAL_SetMuxMode(PORT_Type *base, uint32_t pin, port_mux_t mux);
+void PORT_HAL_SetPinIntMode(PORT_Type *base, uint32_t pin, port_interrupt_config_t mode);
+void PORT_HAL_ClearPinIntFlag(PORT_Type *base, uint32_t pin);
+void GPIO_HAL_SetPinDir(GPIO_Type *base, uint32_t pin, gpio_pin_direction_t direction);
+void GPIO_HAL_SetPinOutput(GPIO_Type *base, uint32_t pin);
+void GPIO_HAL_ClearPinOutput(GPIO_Type *base, uint32_t pin);
+uint32_t GPIO_HAL_ReadPinInput(GPIO_Type *base, uint32_t pin);
+
+/*                     Clocks / SIM                      */
+typedef struct
+{
+    volatile uint32_t SOPT2;
+    volatile uint32_t SOPT4;
+    volatile uint32_t SOPT7;
+} SIM_Type;
+
+extern SIM_Type sil_sim;
+#define SIM                             (&sil_sim)
+
+#define SIM_SOPT7_ADC0TRGSEL_MASK       0xFU
+#define SIM_SOPT7_ADC0TRGSEL(x)         ((uint32_t)(x) & SIM_SOPT7_ADC0TRGSEL_MASK)
+#define SIM_SOPT7_ADC0PRETRGSEL_MASK    0x10U
+#define SIM_SOPT7_ADC0ALTTRGEN_MASK     0x80U
+
+typedef enum
+{
+    kClockTpmSrcNone = 0, kClockTpmSrcPllFllSel, kClockTpmSrcOsc0erClk, kClockTpmSrcMcgIrClk
+} clock_tpm_src_t;
+
+typedef enum
+{
+    kClockLpsciSrcNone = 0, kClockLpsciSrcPllFllSel, kClockLpsciSrcOsc0erClk, kClockLpsciSrcMcgIrClk
+} clock_lpsci_src_t;
+
+typedef enum
+{
+    kClockLptmrSrcMcgIrClk = 0, kClockLptmrSrcLpoClk, kClockLptmrSrcEr32kClk, kClockLptmrSrcOsc0erClk
+} clock_lptmr_src_t;
+
+void CLOCK_SYS_EnablePortClock(uint32_t instance);
+void CLOCK_SYS_EnableAdcClock(uint32_t instance);
+void CLOCK_SYS_EnableDmaClock(uint32_t instance);
+void CLOCK_SYS_EnableDmamuxClock(uint32_t instance);
+void CLOCK_SYS_SetTpmSrc(uint32_t instance, clock_tpm_src_t source);
+void CLOCK_SYS_SetLpsciSrc(uint32_t instance, clock_lpsci_src_t source);
+void SIM_HAL_SetTpmExternalClkPinSelMode(SIM_Type *base, uint32_t instance, uint32_t select);
+
+/*                          TPM                          */
+#define TPM0_IDX                        0U
+#define TPM1_IDX                        1U
+#define TPM2_IDX                        2U
+
+typedef struct
+{
+    volatile uint32_t SC;
+    volatile uint32_t CNT;
+    volatile uint32_t MOD;
+    struct
+    {
+        volatile uint32_t CnSC;
+        volatile uint32_t CnV;
+    } CONTROLS[6];
+    volatile uint32_t STATUS;
+    volatile uint32_t CONF;
+} TPM_Type;
+
+extern TPM_Type sil_tpm[3];
+#define TPM0                            (&sil_tpm[TPM0_IDX])
+#define TPM1                            (&sil_tpm[TPM1_IDX])
+#define TPM2                            (&sil_tpm[TPM2_IDX])
+#define TPM_CNT_REG(base)               ((base)->CNT)
+#define TPM_MOD_REG(base)               ((base)->MOD)
+#define TPM_CnV_REG(base, index)        ((base)->CONTROLS[index].CnV)
+
+#define TPM_SC_PS_MASK                  0x7U
+#define TPM_SC_CMOD_MASK                0x18U
+#define TPM_SC_CMOD_SHIFT               3U
+#define TPM_SC_CPWMS_MASK               0x20U
+#define TPM_SC_TOIE_MASK                0x40U
+#define TPM_SC_TOF_MASK                 0x80U
+#define TPM_CnSC_ELSA_MASK              0x04U
+#define TPM_CnSC_ELSB_MASK              0x08U
+#define TPM_CnSC_MSA_MASK               0x10U
+#define TPM_CnSC_MSB_MASK               0x20U
+#define TPM_CnSC_CHIE_MASK              0x40U
+#define TPM_CnSC_CHF_MASK               0x80U
+
+typedef enum
+{
+    kTpmClockSourceNoneClk = 0, kTpmClockSourceModuleClk, kTpmClockSourceExternalClk
+} tpm_clock_mode_t;
+
+typedef enum
+{
+    kTpmDividedBy1 = 0, kTpmDividedBy2, kTpmDividedBy4, kTpmDividedBy8,
+    kTpmDividedBy16, kTpmDividedBy32, kTpmDividedBy64, kTpmDividedBy128
+} tpm_clock_ps_t;
+
+typedef enum
+{
+    kTpmEdgeAlignedPWM = 0, kTpmCenterAlignedPWM
+} tpm_pwm_mode_t;
+
+typedef enum
+{
+    kTpmHighTrue = 0, kTpmLowTrue
+} tpm_pwm_edge_mode_t;
+
+typedef struct
+{
+    bool isDBGMode;
+    bool isGlobalTimeBase;
+    bool isTriggerMode;
+    bool isStopCountOnOveflow;
+    bool isCountReloadOnTrig;
+    uint8_t triggerSource;
+} tpm_general_config_t;
+
+typedef struct
+{
+    tpm_pwm_mode_t mode;
+    tpm_pwm_edge_mode_t edgeMode;
+    uint32_t uFrequencyHZ;
+    uint32_t uDutyCyclePercent;
+} tpm_pwm_param_t;
+
+typedef enum
+{
+    kStatus_TPM_Success = 0, kStatus_TPM_Fail
+} tpm_status_t;
+
+tpm_status_t TPM_DRV_Init(uint32_t instance, const tpm_general_config_t *info);
+void TPM_DRV_SetClock(uint32_t instance, tpm_clock_mode_t clock, tpm_clock_ps_t clockPs);
+tpm_status_t TPM_DRV_PwmStart(uint32_t instance, tpm_pwm_param_t *param, uint8_t channel);
+void TPM_HAL_SetClockMode(TPM_Type *base, tpm_clock_mode_t mode);
+tpm_clock_mode_t TPM_HAL_GetClockMode(TPM_Type *base);
+void TPM_HAL_SetCpwms(TPM_Type *base, uint8_t mode);
+void TPM_HAL_SetClockDiv(TPM_Type *base, tpm_clock_ps_t ps);
+void TPM_HAL_SetMod(TPM_Type *base, uint16_t value);
+uint32_t TPM_HAL_GetMod(TPM_Type *base);
+void TPM_HAL_ClearCounter(TPM_Type *base);
+uint32_t TPM_HAL_GetCounterVal(TPM_Type *base);
+void TPM_HAL_SetChnCountVal(TPM_Type *base, uint32_t channel, uint16_t value);
+uint32_t TPM_HAL_GetChnCountVal(TPM_Type *base, uint32_t channel);
+void TPM_HAL_SetChnMsnbaElsnbaVal(TPM_Type *base, uint32_t channel, uint32_t value);
+void TPM_HAL_EnableChnInt(TPM_Type *base, uint32_t channel);
+void TPM_HAL_DisableChnInt(TPM_Type *base, uint32_t channel);
+void TPM_HAL_ClearChnInt(TPM_Type *base, uint32_t channel);
+bool TPM_HAL_GetChnStatus(TPM_Type *base, uint32_t channel);
+void TPM_HAL_EnableTimerOverflowInt(TPM_Type *base);
+void TPM_HAL_DisableTimerOverflowInt(TPM_Type *base);
+void TPM_HAL_ClearTimerOverflowFlag(TPM_Type *base);
+bool TPM_HAL_GetTimerOverflowStatus(TPM_Type *base);
+
+/*                          ADC                          */
+typedef struct
+{
+    volatile uint32_t SC1[2];
+    volatile uint32_t CFG1;
+    volatile uint32_t CFG2;
+    volatile uint32_t R[2];
+    volatile uint32_t CV1;
+    volatile uint32_t CV2;
+    volatile uint32_t SC2;
+    volatile uint32_t SC3;
+    volatile uint32_t OFS;
+    volatile uint32_t PG;
+    volatile uint32_t MG;
+    volatile uint32_t CLPD;
+    volatile uint32_t CLPS;
+    volatile uint32_t CLP4;
+    volatile uint32_t CLP3;
+    volatile uint32_t CLP2;
+    volatile uint32_t CLP1;
+    volatile uint32_t CLP0;
+    volatile uint32_t CLMD;
+    volatile uint32_t CLMS;
+    volatile uint32_t CLM4;
+    volatile uint32_t CLM3;
+    volatile uint32_t CLM2;
+    volatile uint32_t CLM1;
+    volatile uint32_t CLM0;
+} ADC_Type;
+
+/* Accessor, so a calibration started by the firmware completes when polled */
+ADC_Type *sil_adc0(void);
+#define ADC0                            (sil_adc0())
+
+#define ADC_SC1_ADCH_MASK               0x1FU
+#define ADC_SC1_ADCH(x)                 ((uint32_t)(x) & ADC_SC1_ADCH_MASK)
+#define ADC_SC1_AIEN_MASK               0x40U
+#define ADC_SC1_COCO_MASK               0x80U
+#define ADC_CFG1_ADICLK_MASK            0x3U
+#define ADC_CFG1_MODE_MASK              0xCU
+#define ADC_CFG1_MODE(x)                (((uint32_t)(x) << 2) & ADC_CFG1_MODE_MASK)
+#define ADC_CFG1_ADLSMP_MASK            0x10U
+#define ADC_CFG1_ADIV_MASK              0x60U
+#define ADC_CFG1_ADIV(x)                (((uint32_t)(x) << 5) & ADC_CFG1_ADIV_MASK)
+#define ADC_SC2_REFSEL_MASK             0x3U
+#define ADC_SC2_DMAEN_MASK              0x4U
+#define ADC_SC2_ADTRG_MASK              0x40U
+#define ADC_SC3_AVGS_MASK               0x3U
+#define ADC_SC3_AVGS(x)                 ((uint32_t)(x) & ADC_SC3_AVGS_MASK)
+#define ADC_SC3_AVGE_MASK               0x4U
+#define ADC_SC3_CALF_MASK               0x40U
+#define ADC_SC3_CAL_MASK                0x80U
+
+/*                       DMA / DMAMUX                    */
+/* Addresses are host pointers here */
+typedef struct
+{
+    struct
+    {
+        volatile uintptr_t SAR;
+        volatile uintptr_t DAR;
+        volatile uint32_t DSR_BCR;
+        volatile uint32_t DCR;
+    } DMA[4];
+} DMA_Type;
+
+typedef struct
+{
+    volatile uint8_t CHCFG[4];
+} DMAMUX_Type;
+
+extern DMA_Type sil_dma;
+extern DMAMUX_Type sil_dmamux;
+#define DMA0                            (&sil_dma)
+#define DMAMUX0                         (&sil_dmamux)
+
+#define DMA_DSR_BCR_BCR_MASK            0xFFFFFFU
+#define DMA_DSR_BCR_BCR(x)              ((uint32_t)(x) & DMA_DSR_BCR_BCR_MASK)
+#define DMA_DSR_BCR_DONE_MASK           0x1000000U
+#define DMA_DSR_BCR_BSY_MASK            0x2000000U
+#define DMA_DSR_BCR_REQ_MASK            0x4000000U
+#define DMA_DSR_BCR_BED_MASK            0x10000000U
+#define DMA_DSR_BCR_BES_MASK            0x20000000U
+#define DMA_DSR_BCR_CE_MASK             0x40000000U
+#define DMA_DCR_DMOD_MASK               0xF00U
+#define DMA_DCR_DMOD_SHIFT              8U
+#define DMA_DCR_DMOD(x)                 (((uint32_t)(x) << DMA_DCR_DMOD_SHIFT) & DMA_DCR_DMOD_MASK)
+#define DMA_DCR_SMOD_MASK               0xF000U
+#define DMA_DCR_DSIZE_MASK              0x60000U
+#define DMA_DCR_DSIZE_SHIFT             17U
+#define DMA_DCR_DSIZE(x)                (((uint32_t)(x) << DMA_DCR_DSIZE_SHIFT) & DMA_DCR_DSIZE_MASK)
+#define DMA_DCR_DINC_MASK               0x80000U
+#define DMA_DCR_SSIZE_MASK              0x300000U
+#define DMA_DCR_SSIZE_SHIFT             20U
+#define DMA_DCR_SSIZE(x)                (((uint32_t)(x) << DMA_DCR_SSIZE_SHIFT) & DMA_DCR_SSIZE_MASK)
+#define DMA_DCR_SINC_MASK               0x400000U
+#define DMA_DCR_CS_MASK                 0x20000000U
+#define DMA_DCR_ERQ_MASK                0x40000000U
+#define DMA_DCR_EINT_MASK               0x80000000U
+#define DMAMUX_CHCFG_SOURCE_MASK        0x3FU
+#define DMAMUX_CHCFG_SOURCE(x)          ((uint8_t)(x) & DMAMUX_CHCFG_SOURCE_MASK)
+#define DMAMUX_CHCFG_ENBL_MASK          0x80U
+
+/*                         UART0                         */
+#define UART0_IDX                       0U
+
+typedef struct
+{
+    volatile uint8_t C2;
+    volatile uint8_t S1;
+} UART0_Type;
+
+extern UART0_Type sil_uart0;
+#define UART0                           (&sil_uart0)
+
+#define UART0_C2_RIE_MASK               0x20U
+#define UART0_C2_TIE_MASK               0x80U
+#define UART0_S1_OR_MASK                0x08U
+#define UART0_S1_RDRF_MASK              0x20U
+#define UART0_S1_TDRE_MASK              0x80U
+
+/* Data register accesses are hooks into the simulated line */
+uint8_t sil_uartReadData(void);
+void sil_uartWriteData(uint8_t ucData);
+
+#define UART0_BRD_C2_TIE(base)          (((base)->C2 & UART0_C2_TIE_MASK) != 0)
+#define UART0_BWR_C2_TIE(base, value)   ((base)->C2 = (uint8_t)(((base)->C2 & ~UART0_C2_TIE_MASK) | ((value) ? UART0_C2_TIE_MASK : 0)))
+#define UART0_BRD_C2_RIE(base)          (((base)->C2 & UART0_C2_RIE_MASK) != 0)
+#define UART0_BWR_C2_RIE(base, value)   ((base)->C2 = (uint8_t)(((base)->C2 & ~UART0_C2_RIE_MASK) | ((value) ? UART0_C2_RIE_MASK : 0)))
+#define UART0_BRD_S1_TDRE(base)         (((base)->S1 & UART0_S1_TDRE_MASK) != 0)
+#define UART0_BRD_S1_RDRF(base)         (((base)->S1 & UART0_S1_RDRF_MASK) != 0)
+#define UART0_BRD_S1_OR(base)           (((base)->S1 & UART0_S1_OR_MASK) != 0)
+#define UART0_WR_S1(base, value)        ((base)->S1 = (uint8_t)((base)->S1 & ~((value) & UART0_S1_OR_MASK)))
+#define UART0_RD_D(base)                (sil_uartReadData())
+#define UART0_WR_D(base, value)         (sil_uartWriteData((uint8_t)(value)))
+
+/*                     Debug console                     */
+typedef enum
+{
+    kDebugConsoleNone = 0, kDebugConsoleLPSCI = 15, kDebugConsoleUART = 16, kDebugConsoleLPUART = 19
+} debug_console_device_type_t;
+
+typedef enum
+{
+    kStatus_DEBUGCONSOLE_Success = 0, kStatus_DEBUGCONSOLE_Failed
+} debug_console_status_t;
+
+debug_console_status_t DbgConsole_Init(uint32_t uartInstance, uint32_t baudRate, debug_console_device_type_t device);
+int debug_printf(const char *fmt_s, ...);
+#define PRINTF                          debug_printf
+
+/*                         LPTMR                         */
+#define LPTMR0_IDX                      0U
+
+typedef void (*lptmr_callback_t)(void);
+
+typedef enum
+{
+    kLptmrTimerModeTimeCounter = 0, kLptmrTimerModePulseCounter
+} lptmr_timer_mode_t;
+
+typedef enum
+{
+    kLptmrPrescalerDivide2 = 0, kLptmrPrescalerDivide4, kLptmrPrescalerDivide8
+} lptmr_prescaler_value_t;
+
+typedef struct
+{
+    lptmr_timer_mode_t timerMode;
+    bool freeRunningEnable;
+    bool prescalerEnable;
+    clock_lptmr_src_t prescalerClockSource;
+    lptmr_prescaler_value_t prescalerValue;
+    bool isInterruptEnabled;
+} lptmr_user_config_t;
+
+typedef struct
+{
+    lptmr_callback_t userCallbackFunc;
+    uint32_t prescalerClockHz;
+} lptmr_state_t;
+
+typedef enum
+{
+    kStatus_LPTMR_Success = 0, kStatus_LPTMR_Fail
+} lptmr_status_t;
+
+lptmr_status_t LPTMR_DRV_Init(uint32_t instance, lptmr_state_t *userStatePtr, const lptmr_user_config_t *userConfigPtr);
+lptmr_status_t LPTMR_DRV_SetTimerPeriodUs(uint32_t instance, uint32_t us);
+lptmr_status_t LPTMR_DRV_InstallCallback(uint32_t instance, lptmr_callback_t userCallback);
+void LPTMR_DRV_Start(uint32_t instance);
+void LPTMR_DRV_IRQHandler(uint32_t instance);
+
+/*                          SMC                          */
+typedef struct
+{
+    volatile uint8_t PMPROT;
+    volatile uint8_t PMCTRL;
+    volatile uint8_t STOPCTRL;
+    volatile uint8_t PMSTAT;
+} SMC_Type;
+
+extern SMC_Type sil_smc;
+#define SMC                             (&sil_smc)
+
+typedef enum
+{
+    kPowerModeRun, kPowerModeWait, kPowerModeStop, kPowerModeVlpr,
+    kPowerModeVlpw, kPowerModeVlps, kPowerModeLls, kPowerModeVlls, kPowerModeMax
+} power_modes_t;
+
+typedef enum
+{
+    kSmcHalSuccess, kSmcHalNoSuchModeName, kSmcHalAlreadyInTheState, kSmcHalFailed
+} smc_hal_error_code_t;
+
+typedef struct
+{
+    power_modes_t powerModeName;
+    uint32_t stopSubMode;
+} smc_power_mode_config_t;
+
+typedef struct
+{
+    bool vlpProt;
+    bool llsProt;
+    bool vllsProt;
+} smc_power_mode_protection_config_t;
+
+smc_hal_error_code_t SMC_HAL_SetMode(SMC_Type *base, const smc_power_mode_config_t *powerModeConfig);
+void SMC_HAL_SetProtection(SMC_Type *base, smc_power_mode_protection_config_t *protectConfig);
+
+/*                          MCG                          */
+void mcg_clockInit(void);
+
+#endif /* SIL_HW_H_ */
@@ -0,0 +1,73 @@
+/**
+ *
+ * File name:           sil.h
+ * File description:    File containing the interface between the
+ *                      software-in-the-loop simulation thread and the
+ *                      simulated peripherals.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SIL_H_
+#define SIL_H_
+
+/* Project includes */
+#include "sil_hw.h"
+#include "sil_motor.h"
+
+/* Plant driven by the simulated H-bridge */
+extern t_SIL_Motor tSilMotor;
+
+/* Firmware interrupt handlers */
+void UART0_IRQHandler(void);
+void PORTD_IRQHandler(void);
+void TPM0_IRQHandler(void);
+void TPM1_IRQHandler(void);
+void TPM2_IRQHandler(void);
+void LPTMR0_IRQHandler(void);
+void DMA0_IRQHandler(void);
+
+/* Firmware entry point, main.c is built with -Dmain=firmware_main */
+int firmware_main(void);
+
+/**
+ * Method name:         sil_hwInit
+ * Method description:  Resets the simulated peripherals and connects the UART to host descriptors
+ * Input params:        iRxFd = Descriptor the firmware receives from, non-blocking
+ *                      iTxFd = Descriptor the firmware transmits to
+ * Output params:       n/a
+ */
+void sil_hwInit(int iRxFd, int iTxFd);
+
+/**
+ * Method name:         sil_hwSetLockstep
+ * Method description:  Selects whether the simulation waits for the firmware to go back to sleep
+ *                      after waking it, so firmware work takes no simulated time
+ * Input params:        bLockstep = true to wait
+ * Output params:       n/a
+ */
+void sil_hwSetLockstep(bool bLockstep);
+
+/**
+ * Method name:         sil_hwStep
+ * Method description:  Advances the plant and all simulated peripherals
+ * Input params:        dDt = Time step [s]
+ * Output params:       n/a
+ */
+void sil_hwStep(double dDt);
+
+/**
+ * Method name:         sil_hwDuty
+ * Method description:  Returns the H-bridge command currently applied to the plant
+ * Input params:        n/a
+ * Output params:       double = -1 (full reverse) to 1 (full ahead)
+ */
+double sil_hwDuty(void);
+
+#endif /* SIL_H_ */
@@ -0,0 +1,1030 @@
+/**
+ *
+ * File name:           sil_hw.c
+ * File description:    File containing the simulated KL25Z peripherals used
+ *                      by the software-in-the-loop host build.
+ *
+ *                      - TPM0 PWM duty drives the motor plant model.
+ *                      - TPMs on the module clock count at OSCERCLK over the
+ *                        prescaler and raise the overflow interrupt.
+ *                      - Every quadrature edge of the plant encoder clocks the
+ *                        pulse counter, is captured by the capture TPM and
+ *                        raises the index (channel O) interrupt once a turn.
+ *                      - UART0 moves one byte per bit-time slot at
+ *                        HMI_UART_BAUD between the firmware and a host file
+ *                        descriptor pair.
+ *                      - LPTMR0 raises its interrupt every configured period.
+ *                      - Low power modes block the firmware thread until an
+ *                        interrupt is raised. In lockstep, a step that wakes
+ *                        the firmware only ends once it sleeps again, so a
+ *                        firmware cycle takes no simulated time. A firmware
+ *                        that busy-waits on the simulation (e.g. a transmit
+ *                        flush) drops lockstep until it next sleeps.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <errno.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "sil.h"
+#include "hal/target_definitions.h"
+
+/* ADC0 result range, 12 bits */
+#define SIL_ADC_FULL_SCALE          4096
+/* ADC0 DMA request source */
+#define SIL_DMAMUX_SOURCE_ADC0      40U
+/* SOPT7 trigger select of the TPM0 overflow */
+#define SIL_ADC_TRIGGER_TPM0        8U
+
+/* Encoder resolution of the simulated motor, pulses per revolution */
+#define SIL_ENCODER_PULSES          1024
+/* Bits per UART frame: start, 8 data, stop */
+#define SIL_UART_FRAME_BITS         10
+/* Host side receive queue */
+#define SIL_UART_RX_QUEUE_SIZE      256
+
+/* Registers */
+PORT_Type sil_port[5];
+GPIO_Type sil_gpio[5];
+SIM_Type sil_sim;
+TPM_Type sil_tpm[3];
+UART0_Type sil_uart0;
+DMA_Type sil_dma;
+DMAMUX_Type sil_dmamux;
+static ADC_Type tSilAdc0;
+static SysTick_Type tSilSysTick;
+
+/* Host time the simulation waits for the firmware to sleep again */
+#define SIL_LOCKSTEP_TIMEOUT_NS     50000000L
+/* Host time the simulation waits for the firmware to finish its initialization */
+#define SIL_STARTUP_TIMEOUT_NS      1000000000L
+
+/* Interrupt controller */
+static volatile bool bSilIrqEnabled[SIL_IRQ_COUNT];
+static pthread_mutex_t tSilIrqLock;
+static __thread int iSilIrqDepth = 0;
+
+/* Low power modes, all protected by the interrupt lock */
+SMC_Type sil_smc;
+static pthread_cond_t tSilWakeCond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t tSilSleepCond = PTHREAD_COND_INITIALIZER;
+static uint32_t uiSilIrqCount = 0;
+static uint32_t uiSilSleepCount = 0;
+static bool bSilSleeping = false;
+static bool bSilWoken = false;
+static bool bSilLockstep = true;
+static bool bSilFreeRun = false;
+
+/* TPM module clock, fractional ticks carried between steps */
+static double dSilTpmTicks[3];
+/* Ticks already counted in the current step */
+static unsigned long ulSilTpmCounted[3];
+
+/* Plant */
+t_SIL_Motor tSilMotor;
+/* Encoder position in quadrature counts */
+static long lSilEncoderQuarter = 0;
+
+/* UART line */
+static int iSilUartRxFd = -1, iSilUartTxFd = -1;
+static double dSilUartSlots = 0;
+static uint8_t ucSilUartRxData;
+static bool bSilUartTxWritten;
+static uint8_t ucSilUartTxByte;
+static uint8_t ucSilUartRxQueue[SIL_UART_RX_QUEUE_SIZE];
+static int iSilUartRxQueueHead = 0, iSilUartRxQueueCount = 0;
+
+/* LPTMR */
+static lptmr_callback_t tSilLptmrCallback = NULL;
+static double dSilLptmrPeriod = 0;
+static double dSilLptmrElapsed = 0;
+static volatile bool bSilLptmrRunning = false;
+
+/* Default handlers, overridden by the firmware definitions */
+__attribute__((weak)) void UART0_IRQHandler(void) {}
+__attribute__((weak)) void PORTD_IRQHandler(void) {}
+__attribute__((weak)) void TPM0_IRQHandler(void) {}
+__attribute__((weak)) void TPM1_IRQHandler(void) {}
+__attribute__((weak)) void TPM2_IRQHandler(void) {}
+
+/* Interrupt vector of each TPM */
+static void (*const pSilTpmHandler[3])(void) = {TPM0_IRQHandler, TPM1_IRQHandler, TPM2_IRQHandler};
+__attribute__((weak)) void LPTMR0_IRQHandler(void) {}
+__attribute__((weak)) void DMA0_IRQHandler(void) {}
+
+/* Interrupt vector of each DMA channel, only channel 0 is used */
+static void (*const pSilDmaHandler[4])(void) = {DMA0_IRQHandler, DMA0_IRQHandler, DMA0_IRQHandler, DMA0_IRQHandler};
+
+/**
+ * Method name:         sil_raiseIrq
+ * Method description:  Runs an interrupt handler if its IRQ is enabled, holding the interrupt lock
+ * Input params:        tIrq = IRQ number
+ *                      handler = IRQ handler
+ * Output params:       n/a
+ */
+static void sil_raiseIrq(IRQn_Type tIrq, void (*handler)(void))
+{
+    if(!bSilIrqEnabled[tIrq])
+        return;
+    __disable_irq();
+    handler();
+    /* Any interrupt ends WFI */
+    uiSilIrqCount++;
+    if(bSilSleeping)
+    {
+        bSilWoken = true;
+        pthread_cond_broadcast(&tSilWakeCond);
+    }
+    __enable_irq();
+}
+
+/*                        Core                           */
+void NVIC_EnableIRQ(IRQn_Type tIrq)
+{
+    bSilIrqEnabled[tIrq] = true;
+}
+
+void NVIC_DisableIRQ(IRQn_Type tIrq)
+{
+    bSilIrqEnabled[tIrq] = false;
+}
+
+/* Interrupts do not nest here, priorities are ignored */
+void NVIC_SetPriority(IRQn_Type tIrq, uint32_t uiPriority)
+{
+    (void)tIrq;
+    (void)uiPriority;
+}
+
+void __disable_irq(void)
+{
+    if(0 == iSilIrqDepth++)
+        pthread_mutex_lock(&tSilIrqLock);
+}
+
+void __enable_irq(void)
+{
+    if(iSilIrqDepth > 0 && 0 == --iSilIrqDepth)
+        pthread_mutex_unlock(&tSilIrqLock);
+}
+
+/* PRIMASK is the lock depth here, the firmware only hands it back to __set_PRIMASK */
+uint32_t __get_PRIMASK(void)
+{
+    return (uint32_t)iSilIrqDepth;
+}
+
+void __set_PRIMASK(uint32_t uiPriMask)
+{
+    while((uint32_t)iSilIrqDepth > uiPriMask)
+        __enable_irq();
+    while((uint32_t)iSilIrqDepth < uiPriMask)
+        __disable_irq();
+}
+
+SysTick_Type *sil_sysTick(void)
+{
+    struct timespec tNow;
+    uint64_t ullCycles;
+
+    if(tSilSysTick.CTRL & SysTick_CTRL_ENABLE_Msk)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &tNow);
+        ullCycles = ((uint64_t)tNow.tv_sec*1000000000ULL + tNow.tv_nsec) * (SIL_CORE_CLOCK_HZ/1000000) / 1000;
+        tSilSysTick.VAL = tSilSysTick.LOAD - (uint32_t)(ullCycles % ((uint64_t)tSilSysTick.LOAD + 1));
+    }
+    return &tSilSysTick;
+}
+
+void mcg_clockInit(void)
+{
+}
+
+/*                          SMC                          */
+smc_hal_error_code_t SMC_HAL_SetMode(SMC_Type *base, const smc_power_mode_config_t *powerModeConfig)
+{
+    uint32_t uiIrqCount;
+
+    (void)base;
+    if(kPowerModeRun == powerModeConfig->powerModeName)
+        return kSmcHalSuccess;
+
+    /* WFI: returns on any interrupt, even with PRIMASK set */
+    __disable_irq();
+    uiIrqCount = uiSilIrqCount;
+    bSilSleeping = true;
+    bSilFreeRun = false;
+    uiSilSleepCount++;
+    pthread_cond_broadcast(&tSilSleepCond);
+    while(uiIrqCount == uiSilIrqCount)
+        pthread_cond_wait(&tSilWakeCond, &tSilIrqLock);
+    bSilSleeping = false;
+    __enable_irq();
+    return kSmcHalSuccess;
+}
+
+void SMC_HAL_SetProtection(SMC_Type *base, smc_power_mode_protection_config_t *protectConfig)
+{
+    base->PMPROT = (protectConfig->vlpProt ? 0x20 : 0) | (protectConfig->llsProt ? 0x08 : 0) | (protectConfig->vllsProt ? 0x02 : 0);
+}
+
+/*                        Ports                          */
+void PORT_HAL_SetMuxMode(PORT_Type *base, uint32_t pin, port_mux_t mux)
+{
+    base->PCR[pin] = (base->PCR[pin] & ~0x700U) | ((uint32_t)mux << 8);
+}
+
+void PORT_HAL_SetPinIntMode(PORT_Type *base, uint32_t pin, port_interrupt_config_t mode)
+{
+    base->PCR[pin] = (base->PCR[pin] & ~0xF0000U) | ((uint32_t)mode << 16);
+}
+
+void PORT_HAL_ClearPinIntFlag(PORT_Type *base, uint32_t pin)
+{
+    base->ISFR &= ~(1U << pin);
+}
+
+void GPIO_HAL_SetPinDir(GPIO_Type *base, uint32_t pin, gpio_pin_direction_t direction)
+{
+    if(kGpioDigitalOutput == direction)
+        base->PDDR |= 1U << pin;
+    else
+        base->PDDR &= ~(1U << pin);
+}
+
+void GPIO_HAL_SetPinOutput(GPIO_Type *base, uint32_t pin)
+{
+    base->PDOR |= 1U << pin;
+}
+
+void GPIO_HAL_ClearPinOutput(GPIO_Type *base, uint32_t pin)
+{
+    base->PDOR &= ~(1U << pin);
+}
+
+uint32_t GPIO_HAL_ReadPinInput(GPIO_Type *base, uint32_t pin)
+{
+    return (base->PDIR >> pin) & 1U;
+}
+
+/*                     Clocks / SIM                      */
+void CLOCK_SYS_EnablePortClock(uint32_t instance)
+{
+    (void)instance;
+}
+
+void CLOCK_SYS_EnableAdcClock(uint32_t instance)
+{
+    (void)instance;
+}
+
+void CLOCK_SYS_EnableDmaClock(uint32_t instance)
+{
+    (void)instance;
+}
+
+void CLOCK_SYS_EnableDmamuxClock(uint32_t instance)
+{
+    (void)instance;
+}
+
+void CLOCK_SYS_SetTpmSrc(uint32_t instance, clock_tpm_src_t source)
+{
+    (void)instance;
+    sil_sim.SOPT2 = (uint32_t)source;
+}
+
+void CLOCK_SYS_SetLpsciSrc(uint32_t instance, clock_lpsci_src_t source)
+{
+    (void)instance;
+    (void)source;
+}
+
+void SIM_HAL_SetTpmExternalClkPinSelMode(SIM_Type *base, uint32_t instance, uint32_t select)
+{
+    base->SOPT4 = (base->SOPT4 & ~(1U << (24 + instance))) | (select << (24 + instance));
+}
+
+/*                          TPM                          */
+tpm_status_t TPM_DRV_Init(uint32_t instance, const tpm_general_config_t *info)
+{
+    (void)info;
+    sil_tpm[instance].SC = 0;
+    sil_tpm[instance].CNT = 0;
+    sil_tpm[instance].MOD = 0xFFFF;
+    return kStatus_TPM_Success;
+}
+
+void TPM_DRV_SetClock(uint32_t instance, tpm_clock_mode_t clock, tpm_clock_ps_t clockPs)
+{
+    TPM_HAL_SetClockDiv(&sil_tpm[instance], clockPs);
+    TPM_HAL_SetClockMode(&sil_tpm[instance], clock);
+}
+
+tpm_status_t TPM_DRV_PwmStart(uint32_t instance, tpm_pwm_param_t *param, uint8_t channel)
+{
+    TPM_Type *base = &sil_tpm[instance];
+    uint32_t uiClock = SIL_OSCERCLK_HZ >> (base->SC & TPM_SC_PS_MASK);
+
+    if(kTpmCenterAlignedPWM == param->mode)
+    {
+        base->SC |= TPM_SC_CPWMS_MASK;
+        base->MOD = uiClock / (2*param->uFrequencyHZ);
+    }
+    else
+    {
+        base->SC &= ~TPM_SC_CPWMS_MASK;
+        base->MOD = uiClock / param->uFrequencyHZ - 1;
+    }
+    /* MSB plus ELSB (high true) or ELSA (low true) */
+    base->CONTROLS[channel].CnSC = (kTpmHighTrue == param->edgeMode) ? 0x28 : 0x24;
+    base->CONTROLS[channel].CnV = base->MOD * param->uDutyCyclePercent / 100;
+    return kStatus_TPM_Success;
+}
+
+void TPM_HAL_SetClockMode(TPM_Type *base, tpm_clock_mode_t mode)
+{
+    base->SC = (base->SC & ~TPM_SC_CMOD_MASK) | ((uint32_t)mode << TPM_SC_CMOD_SHIFT);
+}
+
+tpm_clock_mode_t TPM_HAL_GetClockMode(TPM_Type *base)
+{
+    return (tpm_clock_mode_t)((base->SC & TPM_SC_CMOD_MASK) >> TPM_SC_CMOD_SHIFT);
+}
+
+void TPM_HAL_SetCpwms(TPM_Type *base, uint8_t mode)
+{
+    base->SC = mode ? (base->SC | TPM_SC_CPWMS_MASK) : (base->SC & ~TPM_SC_CPWMS_MASK);
+}
+
+void TPM_HAL_SetClockDiv(TPM_Type *base, tpm_clock_ps_t ps)
+{
+    base->SC = (base->SC & ~TPM_SC_PS_MASK) | (uint32_t)ps;
+}
+
+void TPM_HAL_SetMod(TPM_Type *base, uint16_t value)
+{
+    base->MOD = value;
+}
+
+uint32_t TPM_HAL_GetMod(TPM_Type *base)
+{
+    return base->MOD;
+}
+
+void TPM_HAL_ClearCounter(TPM_Type *base)
+{
+    base->CNT = 0;
+}
+
+uint32_t TPM_HAL_GetCounterVal(TPM_Type *base)
+{
+    return base->CNT;
+}
+
+void TPM_HAL_SetChnCountVal(TPM_Type *base, uint32_t channel, uint16_t value)
+{
+    base->CONTROLS[channel].CnV = value;
+}
+
+uint32_t TPM_HAL_GetChnCountVal(TPM_Type *base, uint32_t channel)
+{
+    return base->CONTROLS[channel].CnV;
+}
+
+void TPM_HAL_SetChnMsnbaElsnbaVal(TPM_Type *base, uint32_t channel, uint32_t value)
+{
+    base->CONTROLS[channel].CnSC = (base->CONTROLS[channel].CnSC & TPM_CnSC_CHIE_MASK) | value;
+}
+
+void TPM_HAL_EnableChnInt(TPM_Type *base, uint32_t channel)
+{
+    base->CONTROLS[channel].CnSC |= TPM_CnSC_CHIE_MASK;
+}
+
+void TPM_HAL_DisableChnInt(TPM_Type *base, uint32_t channel)
+{
+    base->CONTROLS[channel].CnSC &= ~TPM_CnSC_CHIE_MASK;
+}
+
+void TPM_HAL_ClearChnInt(TPM_Type *base, uint32_t channel)
+{
+    base->CONTROLS[channel].CnSC &= ~TPM_CnSC_CHF_MASK;
+    base->STATUS &= ~(1U << channel);
+}
+
+bool TPM_HAL_GetChnStatus(TPM_Type *base, uint32_t channel)
+{
+    return (base->CONTROLS[channel].CnSC & TPM_CnSC_CHF_MASK) != 0;
+}
+
+void TPM_HAL_EnableTimerOverflowInt(TPM_Type *base)
+{
+    base->SC |= TPM_SC_TOIE_MASK;
+}
+
+void TPM_HAL_DisableTimerOverflowInt(TPM_Type *base)
+{
+    base->SC &= ~TPM_SC_TOIE_MASK;
+}
+
+void TPM_HAL_ClearTimerOverflowFlag(TPM_Type *base)
+{
+    base->SC &= ~TPM_SC_TOF_MASK;
+}
+
+bool TPM_HAL_GetTimerOverflowStatus(TPM_Type *base)
+{
+    return (base->SC & TPM_SC_TOF_MASK) != 0;
+}
+
+/*                         UART0                         */
+uint8_t sil_uartReadData(void)
+{
+    sil_uart0.S1 &= ~UART0_S1_RDRF_MASK;
+    return ucSilUartRxData;
+}
+
+void sil_uartWriteData(uint8_t ucData)
+{
+    sil_uart0.S1 &= ~UART0_S1_TDRE_MASK;
+    ucSilUartTxByte = ucData;
+    bSilUartTxWritten = true;
+}
+
+debug_console_status_t DbgConsole_Init(uint32_t uartInstance, uint32_t baudRate, debug_console_device_type_t device)
+{
+    (void)uartInstance;
+    (void)baudRate;
+    (void)device;
+    sil_uart0.S1 = UART0_S1_TDRE_MASK;
+    return kStatus_DEBUGCONSOLE_Success;
+}
+
+int debug_printf(const char *fmt_s, ...)
+{
+    va_list ap;
+    int iResult;
+
+    va_start(ap, fmt_s);
+    iResult = vfprintf(stderr, fmt_s, ap);
+    va_end(ap);
+    return iResult;
+}
+
+/*                         LPTMR                         */
+lptmr_status_t LPTMR_DRV_Init(uint32_t instance, lptmr_state_t *userStatePtr, const lptmr_user_config_t *userConfigPtr)
+{
+    (void)instance;
+    (void)userStatePtr;
+    if(userConfigPtr->isInterruptEnabled)
+        NVIC_EnableIRQ(LPTMR0_IRQn);
+    return kStatus_LPTMR_Success;
+}
+
+lptmr_status_t LPTMR_DRV_SetTimerPeriodUs(uint32_t instance, uint32_t us)
+{
+    (void)instance;
+    dSilLptmrPeriod = us * 1e-6;
+    return kStatus_LPTMR_Success;
+}
+
+lptmr_status_t LPTMR_DRV_InstallCallback(uint32_t instance, lptmr_callback_t userCallback)
+{
+    (void)instance;
+    tSilLptmrCallback = userCallback;
+    return kStatus_LPTMR_Success;
+}
+
+void LPTMR_DRV_Start(uint32_t instance)
+{
+    (void)instance;
+    dSilLptmrElapsed = 0;
+    bSilLptmrRunning = true;
+}
+
+void LPTMR_DRV_IRQHandler(uint32_t instance)
+{
+    (void)instance;
+    if(tSilLptmrCallback)
+        tSilLptmrCallback();
+}
+
+/*                      Simulation                       */
+
+/**
+ * Method name:         sil_hwInit
+ * Method description:  Resets the simulated peripherals and connects the UART to host descriptors
+ * Input params:        iRxFd = Descriptor the firmware receives from, non-blocking
+ *                      iTxFd = Descriptor the firmware transmits to
+ * Output params:       n/a
+ */
+void sil_hwInit(int iRxFd, int iTxFd)
+{
+    pthread_mutexattr_t tAttr;
+
+    pthread_mutexattr_init(&tAttr);
+    pthread_mutexattr_settype(&tAttr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&tSilIrqLock, &tAttr);
+
+    iSilUartRxFd = iRxFd;
+    iSilUartTxFd = iTxFd;
+    sil_motorInit(&tSilMotor);
+}
+
+/**
+ * Method name:         sil_hwSetLockstep
+ * Method description:  Selects whether the simulation waits for the firmware to go back to sleep
+ *                      after waking it, so firmware work takes no simulated time
+ * Input params:        bLockstep = true to wait
+ * Output params:       n/a
+ */
+void sil_hwSetLockstep(bool bLockstep)
+{
+    bSilLockstep = bLockstep;
+}
+
+/**
+ * Method name:         sil_waitForSleep
+ * Method description:  Lockstep: waits until the firmware woken in this step sleeps again.
+ *                      Called holding the interrupt lock.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void sil_waitForSleep(void)
+{
+    static bool bStarted = false;
+    struct timespec tDeadline;
+    uint32_t uiSleepCount = uiSilSleepCount;
+    long lTimeout = SIL_LOCKSTEP_TIMEOUT_NS;
+
+    if(!bStarted)
+    {
+        /* Initialization takes no simulated time either: hold the first step until the first sleep */
+        bStarted = true;
+        bSilWoken = !bSilSleeping;
+        lTimeout = SIL_STARTUP_TIMEOUT_NS;
+    }
+    if(!bSilWoken)
+        return;
+    bSilWoken = false;
+    if(!bSilLockstep || bSilFreeRun)
+        return;
+
+    clock_gettime(CLOCK_REALTIME, &tDeadline);
+    tDeadline.tv_sec += lTimeout / 1000000000L;
+    tDeadline.tv_nsec += lTimeout % 1000000000L;
+    if(tDeadline.tv_nsec >= 1000000000L)
+    {
+        tDeadline.tv_sec++;
+        tDeadline.tv_nsec -= 1000000000L;
+    }
+    while(uiSleepCount == uiSilSleepCount)
+    {
+        if(ETIMEDOUT == pthread_cond_timedwait(&tSilSleepCond, &tSilIrqLock, &tDeadline))
+        {
+            /* The firmware is waiting for the simulation, run free until it sleeps */
+            bSilFreeRun = true;
+            break;
+        }
+    }
+}
+
+/*                       ADC / DMA                       */
+ADC_Type *sil_adc0(void)
+{
+    /* Calibration finishes at once, with gains close to a real part */
+    if(tSilAdc0.SC3 & ADC_SC3_CAL_MASK)
+    {
+        tSilAdc0.SC3 &= ~(ADC_SC3_CAL_MASK | ADC_SC3_CALF_MASK);
+        tSilAdc0.CLPS = tSilAdc0.CLMS = 0x20;
+        tSilAdc0.CLP4 = tSilAdc0.CLM4 = 0x200;
+        tSilAdc0.CLP3 = tSilAdc0.CLM3 = 0x100;
+        tSilAdc0.CLP2 = tSilAdc0.CLM2 = 0x80;
+        tSilAdc0.CLP1 = tSilAdc0.CLM1 = 0x40;
+        tSilAdc0.CLP0 = tSilAdc0.CLM0 = 0x20;
+        tSilAdc0.SC1[0] |= ADC_SC1_COCO_MASK;
+    }
+    return &tSilAdc0;
+}
+
+/**
+ * Method name:         sil_dmaRequest
+ * Method description:  Serves a peripheral DMA request: one transfer on every enabled channel routed to the source
+ * Input params:        uiSource = DMAMUX source number
+ * Output params:       n/a
+ */
+static void sil_dmaRequest(uint32_t uiSource)
+{
+    static const uint32_t uiSize[4] = {4, 1, 2, 0};
+
+    for(uint32_t i = 0; i < 4; i++)
+    {
+        uint32_t uiDcr = sil_dma.DMA[i].DCR;
+        uint32_t uiBcr = sil_dma.DMA[i].DSR_BCR & DMA_DSR_BCR_BCR_MASK;
+        uint32_t uiSrcSize = uiSize[(uiDcr & DMA_DCR_SSIZE_MASK) >> DMA_DCR_SSIZE_SHIFT];
+        uint32_t uiDstSize = uiSize[(uiDcr & DMA_DCR_DSIZE_MASK) >> DMA_DCR_DSIZE_SHIFT];
+        uint32_t uiDmod = (uiDcr & DMA_DCR_DMOD_MASK) >> DMA_DCR_DMOD_SHIFT;
+        uint32_t uiValue = 0;
+        uintptr_t ulDar;
+
+        if(!(sil_dmamux.CHCFG[i] & DMAMUX_CHCFG_ENBL_MASK) || ((sil_dmamux.CHCFG[i] & DMAMUX_CHCFG_SOURCE_MASK) != uiSource) ||
+                !(uiDcr & DMA_DCR_ERQ_MASK) || !uiBcr)
+            continue;
+        if(!uiSrcSize || (uiSrcSize != uiDstSize) || (uiBcr < uiSrcSize))
+        {
+            sil_dma.DMA[i].DSR_BCR |= DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_DONE_MASK;
+            continue;
+        }
+
+        /* Little-endian host, as the target */
+        memcpy(&uiValue, (const void *)sil_dma.DMA[i].SAR, uiSrcSize);
+        memcpy((void *)sil_dma.DMA[i].DAR, &uiValue, uiDstSize);
+        if(uiDcr & DMA_DCR_SINC_MASK)
+            sil_dma.DMA[i].SAR += uiSrcSize;
+        if(uiDcr & DMA_DCR_DINC_MASK)
+        {
+            ulDar = sil_dma.DMA[i].DAR + uiDstSize;
+            /* Circular buffer of 16 << (DMOD - 1) bytes */
+            if(uiDmod)
+            {
+                uintptr_t ulSize = (uintptr_t)16 << (uiDmod - 1);
+                ulDar = (sil_dma.DMA[i].DAR & ~(ulSize - 1)) | (ulDar & (ulSize - 1));
+            }
+            sil_dma.DMA[i].DAR = ulDar;
+        }
+        uiBcr -= uiSrcSize;
+        sil_dma.DMA[i].DSR_BCR = (sil_dma.DMA[i].DSR_BCR & ~DMA_DSR_BCR_BCR_MASK) | uiBcr;
+        if(!uiBcr)
+        {
+            sil_dma.DMA[i].DSR_BCR |= DMA_DSR_BCR_DONE_MASK;
+            if(uiDcr & DMA_DCR_EINT_MASK)
+                sil_raiseIrq(DMA0_IRQn + i, pSilDmaHandler[i]);
+        }
+    }
+}
+
+/**
+ * Method name:         sil_adcTrigger
+ * Method description:  ADC0 hardware trigger: converts the current sense voltage of the motor model
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void sil_adcTrigger(void)
+{
+    double dMillivolts;
+    long lCounts;
+
+    if(!(tSilAdc0.SC2 & ADC_SC2_ADTRG_MASK) || ((tSilAdc0.SC1[0] & ADC_SC1_ADCH_MASK) != CURRENT_ADC_CHANNEL))
+        return;
+
+    dMillivolts = CURRENT_SENSE_ZERO_MV + tSilMotor.dCurrent*CURRENT_SENSE_MV_PER_A;
+    lCounts = lround(dMillivolts*SIL_ADC_FULL_SCALE/CURRENT_ADC_VREF_MV);
+    if(lCounts < 0)
+        lCounts = 0;
+    if(lCounts > SIL_ADC_FULL_SCALE - 1)
+        lCounts = SIL_ADC_FULL_SCALE - 1;
+    tSilAdc0.R[0] = (uint32_t)lCounts;
+    tSilAdc0.SC1[0] |= ADC_SC1_COCO_MASK;
+
+    /* The DMA reads the result, which clears COCO */
+    if(tSilAdc0.SC2 & ADC_SC2_DMAEN_MASK)
+    {
+        sil_dmaRequest(SIL_DMAMUX_SOURCE_ADC0);
+        tSilAdc0.SC1[0] &= ~ADC_SC1_COCO_MASK;
+    }
+}
+
+/**
+ * Method name:         sil_pwmDuty
+ * Method description:  Returns the bipolar command applied by the H-bridge, from TPM0 and the enable pin
+ * Input params:        n/a
+ * Output params:       double = -1 (full reverse) to 1 (full ahead)
+ */
+static double sil_pwmDuty(void)
+{
+    TPM_Type *base = DRIVER_TPM_BASE;
+    double dPeriod, dHighA, dHighB;
+
+    if(!(DRIVER_EN_GPIO_BASE->PDOR & (1U << DRIVER_EN_PIN_NUMBER)) || !(base->SC & TPM_SC_CMOD_MASK))
+        return 0;
+
+    dPeriod = (base->SC & TPM_SC_CPWMS_MASK) ? base->MOD : base->MOD + 1.0;
+    dHighA = fmin(base->CONTROLS[DRIVER_CHA_INSTANCE].CnV / dPeriod, 1.0);
+    dHighB = fmin(base->CONTROLS[DRIVER_CHB_INSTANCE].CnV / dPeriod, 1.0);
+    /* ELSA set means low true */
+    if(base->CONTROLS[DRIVER_CHA_INSTANCE].CnSC & 0x04)
+        dHighA = 1 - dHighA;
+    if(base->CONTROLS[DRIVER_CHB_INSTANCE].CnSC & 0x04)
+        dHighB = 1 - dHighB;
+
+    return dHighA - dHighB;
+}
+
+/**
+ * Method name:         sil_tpmIndex
+ * Method description:  Returns the instance number of a TPM
+ * Input params:        base = TPM
+ * Output params:       uint32_t = 0 to 2
+ */
+static uint32_t sil_tpmIndex(TPM_Type *base)
+{
+    return (uint32_t)(base - sil_tpm);
+}
+
+/**
+ * Method name:         sil_tpmClockMode
+ * Method description:  Returns the clock a TPM counts
+ * Input params:        base = TPM
+ * Output params:       tpm_clock_mode_t = CMOD field
+ */
+static tpm_clock_mode_t sil_tpmClockMode(TPM_Type *base)
+{
+    return (tpm_clock_mode_t)((base->SC & TPM_SC_CMOD_MASK) >> TPM_SC_CMOD_SHIFT);
+}
+
+/**
+ * Method name:         sil_tpmPendingTicks
+ * Method description:  Returns how many module clock ticks a TPM will count in a step
+ * Input params:        base = TPM
+ *                      dDt = Time step [s]
+ * Output params:       double = Ticks, fractional part included
+ */
+static double sil_tpmPendingTicks(TPM_Type *base, double dDt)
+{
+    if(kTpmClockSourceModuleClk != sil_tpmClockMode(base))
+        return 0;
+    return dSilTpmTicks[sil_tpmIndex(base)] + dDt * (SIL_OSCERCLK_HZ >> (base->SC & TPM_SC_PS_MASK));
+}
+
+/**
+ * Method name:         sil_countPulses
+ * Method description:  Advances a TPM counter, flagging and raising the overflow interrupt on wrap
+ * Input params:        base = TPM
+ *                      ulTicks = Number of counter clocks
+ * Output params:       n/a
+ */
+static void sil_countPulses(TPM_Type *base, unsigned long ulTicks)
+{
+    unsigned long ulCount = base->CNT + ulTicks;
+
+    if(!ulTicks)
+        return;
+    base->CNT = (uint32_t)(ulCount % (base->MOD + 1UL));
+    if(ulCount > base->MOD)
+    {
+        /* TPM0 overflow as the ADC0 hardware trigger, once per overflow */
+        if((TPM0 == base) && (sil_sim.SOPT7 & SIM_SOPT7_ADC0ALTTRGEN_MASK) &&
+                ((sil_sim.SOPT7 & SIM_SOPT7_ADC0TRGSEL_MASK) == SIL_ADC_TRIGGER_TPM0))
+            for(unsigned long ulOverflows = ulCount/(base->MOD + 1UL); ulOverflows; ulOverflows--)
+                sil_adcTrigger();
+
+        base->SC |= TPM_SC_TOF_MASK;
+        if(base->SC & TPM_SC_TOIE_MASK)
+            sil_raiseIrq(TPM0_IRQn + sil_tpmIndex(base), pSilTpmHandler[sil_tpmIndex(base)]);
+    }
+}
+
+/**
+ * Method name:         sil_tpmAdvance
+ * Method description:  Counts a module-clocked TPM up to a point within the current step
+ * Input params:        base = TPM
+ *                      dTicks = Ticks from the start of the step
+ * Output params:       n/a
+ */
+static void sil_tpmAdvance(TPM_Type *base, double dTicks)
+{
+    uint32_t i = sil_tpmIndex(base);
+    unsigned long ulTicks = (unsigned long)dTicks;
+
+    if(ulTicks > ulSilTpmCounted[i])
+    {
+        sil_countPulses(base, ulTicks - ulSilTpmCounted[i]);
+        ulSilTpmCounted[i] = ulTicks;
+    }
+}
+
+/**
+ * Method name:         sil_tpmStep
+ * Method description:  Finishes counting the module-clocked TPMs for the step
+ * Input params:        dDt = Time step [s]
+ * Output params:       n/a
+ */
+static void sil_tpmStep(double dDt)
+{
+    for(uint32_t i = 0; i < 3; i++)
+    {
+        double dTicks = sil_tpmPendingTicks(&sil_tpm[i], dDt);
+        sil_tpmAdvance(&sil_tpm[i], dTicks);
+        dSilTpmTicks[i] = dTicks - floor(dTicks);
+        ulSilTpmCounted[i] = 0;
+    }
+}
+
+/**
+ * Method name:         sil_captureEdge
+ * Method description:  Latches an edge on a TPM channel configured for input capture
+ * Input params:        base = TPM
+ *                      uiChannel = Channel
+ *                      bRising = Edge polarity
+ *                      uiCount = Counter value at the edge
+ * Output params:       n/a
+ */
+static void sil_captureEdge(TPM_Type *base, uint32_t uiChannel, bool bRising, uint32_t uiCount)
+{
+    uint32_t uiCnSC = base->CONTROLS[uiChannel].CnSC;
+
+    /* Input capture is MSB:MSA = 00, ELSA captures rising and ELSB falling edges */
+    if(uiCnSC & (TPM_CnSC_MSA_MASK | TPM_CnSC_MSB_MASK))
+        return;
+    if(!(uiCnSC & (bRising ? TPM_CnSC_ELSA_MASK : TPM_CnSC_ELSB_MASK)))
+        return;
+
+    base->CONTROLS[uiChannel].CnV = uiCount;
+    base->CONTROLS[uiChannel].CnSC |= TPM_CnSC_CHF_MASK;
+    base->STATUS |= 1U << uiChannel;
+    if(uiCnSC & TPM_CnSC_CHIE_MASK)
+        sil_raiseIrq(TPM0_IRQn + sil_tpmIndex(base), pSilTpmHandler[sil_tpmIndex(base)]);
+}
+
+/**
+ * Method name:         sil_encoderStep
+ * Method description:  Converts the plant angle into quadrature edges, captures and index interrupts
+ * Input params:        dDt = Time step [s]
+ * Output params:       n/a
+ */
+static void sil_encoderStep(double dDt)
+{
+    /* (A << 1) | B for each quarter of a pulse, A leading B when turning forward */
+    static const uint32_t uiState[4] = {0, 2, 3, 1};
+    double dQuarter = tSilMotor.dAngle * 4 * SIL_ENCODER_PULSES / (2*M_PI);
+    long lQuarter = (long)floor(dQuarter);
+    long lEdges = labs(lQuarter - lSilEncoderQuarter);
+    int iStep = lQuarter > lSilEncoderQuarter ? 1 : -1;
+    TPM_Type *capture = ENCODER_CAPTURE_TPM_BASE;
+    double dTicks = sil_tpmPendingTicks(capture, dDt);
+
+    for(long i = 1; i <= lEdges; i++)
+    {
+        long lNext = lSilEncoderQuarter + iStep;
+        uint32_t uiOld = uiState[lSilEncoderQuarter & 3];
+        uint32_t uiNew = uiState[lNext & 3];
+
+        /* Edges are spread evenly over the step */
+        sil_tpmAdvance(capture, dTicks * i / (lEdges + 1));
+
+        ENCODER_CAPA_GPIO_BASE->PDIR = (ENCODER_CAPA_GPIO_BASE->PDIR & ~(1U << ENCODER_CAPA_PIN_NUMBER)) | ((uiNew >> 1) << ENCODER_CAPA_PIN_NUMBER);
+        ENCODER_CHB_GPIO_BASE->PDIR = (ENCODER_CHB_GPIO_BASE->PDIR & ~(1U << ENCODER_CHB_PIN_NUMBER)) | ((uiNew & 1) << ENCODER_CHB_PIN_NUMBER);
+        lSilEncoderQuarter = lNext;
+
+        if((uiOld ^ uiNew) & 2)
+        {
+            /* Channel A: pulse counter on rising edges, capture on both */
+            if(uiNew & 2)
+                if(kTpmClockSourceExternalClk == sil_tpmClockMode(ENCODER_CHA_TPM_BASE))
+                    sil_countPulses(ENCODER_CHA_TPM_BASE, 1);
+            sil_captureEdge(capture, ENCODER_CAPA_CHANNEL, (uiNew & 2) != 0, capture->CNT);
+        }
+        else
+            sil_captureEdge(capture, ENCODER_CHB_CHANNEL, (uiNew & 1) != 0, capture->CNT);
+
+        /* Index once a turn, in either direction */
+        if(0 == (iStep > 0 ? lNext : lNext + 1) % (4*SIL_ENCODER_PULSES))
+        {
+            ENCODER_CHO_PORT_BASE->ISFR |= 1U << ENCODER_CHO_PIN_NUMBER;
+            sil_raiseIrq(ENCODER_CHO_IRQn, ENCODER_CHO_IRQ_HANDLER);
+        }
+    }
+}
+
+/**
+ * Method name:         sil_uartOutput
+ * Method description:  Hands transmitted bytes to the host, dropping them if nobody is reading
+ * Input params:        pucData = Bytes
+ *                      iLength = Number of bytes
+ * Output params:       n/a
+ */
+static void sil_uartOutput(const uint8_t *pucData, int iLength)
+{
+    if(write(iSilUartTxFd, pucData, iLength) < 0 && EAGAIN != errno)
+        perror("sil: uart");
+}
+
+/**
+ * Method name:         sil_uartStep
+ * Method description:  Moves the bytes that fit in the elapsed bit time over the UART
+ * Input params:        dDt = Elapsed time [s]
+ * Output params:       n/a
+ */
+static void sil_uartStep(double dDt)
+{
+    uint8_t ucTx[64];
+    int iTxCount = 0;
+    ssize_t lRead;
+
+    /* Refill the host side queue */
+    if(iSilUartRxQueueCount < SIL_UART_RX_QUEUE_SIZE)
+    {
+        uint8_t ucRead[SIL_UART_RX_QUEUE_SIZE];
+        lRead = read(iSilUartRxFd, ucRead, SIL_UART_RX_QUEUE_SIZE - iSilUartRxQueueCount);
+        for(ssize_t i = 0; i < lRead; i++)
+            ucSilUartRxQueue[(iSilUartRxQueueHead + iSilUartRxQueueCount++) % SIL_UART_RX_QUEUE_SIZE] = ucRead[i];
+    }
+
+    dSilUartSlots += dDt * HMI_UART_BAUD / SIL_UART_FRAME_BITS;
+    while(dSilUartSlots >= 1)
+    {
+        dSilUartSlots -= 1;
+
+        /* Receiver */
+        if(iSilUartRxQueueCount)
+        {
+            if(sil_uart0.S1 & UART0_S1_RDRF_MASK)
+                sil_uart0.S1 |= UART0_S1_OR_MASK;
+            else
+            {
+                ucSilUartRxData = ucSilUartRxQueue[iSilUartRxQueueHead];
+                sil_uart0.S1 |= UART0_S1_RDRF_MASK;
+            }
+            iSilUartRxQueueHead = (iSilUartRxQueueHead + 1) % SIL_UART_RX_QUEUE_SIZE;
+            iSilUartRxQueueCount--;
+        }
+
+        /* Transmitter: the previous byte is out, the data register is empty again */
+        sil_uart0.S1 |= UART0_S1_TDRE_MASK;
+        bSilUartTxWritten = false;
+        if(sil_uart0.C2 & (UART0_C2_TIE_MASK | UART0_C2_RIE_MASK))
+            sil_raiseIrq(UART0_IRQn, UART0_IRQHandler);
+        if(bSilUartTxWritten)
+        {
+            ucTx[iTxCount++] = ucSilUartTxByte;
+            if(iTxCount == sizeof(ucTx))
+            {
+                sil_uartOutput(ucTx, iTxCount);
+                iTxCount = 0;
+            }
+        }
+    }
+    if(iTxCount)
+        sil_uartOutput(ucTx, iTxCount);
+}
+
+/**
+ * Method name:         sil_hwStep
+ * Method description:  Advances the plant and all simulated peripherals
+ * Input params:        dDt = Time step [s]
+ * Output params:       n/a
+ */
+void sil_hwStep(double dDt)
+{
+    /* Peripheral state changes atomically with respect to firmware critical sections */
+    __disable_irq();
+    sil_waitForSleep();
+
+    sil_motorStep(&tSilMotor, sil_pwmDuty(), dDt);
+    sil_encoderStep(dDt);
+    sil_tpmStep(dDt);
+    sil_uartStep(dDt);
+
+    if(bSilLptmrRunning)
+    {
+        dSilLptmrElapsed += dDt;
+        if(dSilLptmrElapsed >= dSilLptmrPeriod - 1e-12)
+        {
+            dSilLptmrElapsed -= dSilLptmrPeriod;
+            sil_raiseIrq(LPTMR0_IRQn, LPTMR0_IRQHandler);
+        }
+    }
+
+    sil_waitForSleep();
+    __enable_irq();
+}
+
+/**
+ * Method name:         sil_hwDuty
+ * Method description:  Returns the H-bridge command currently applied to the plant
+ * Input params:        n/a
+ * Output params:       double = -1 (full reverse) to 1 (full ahead)
+ */
+double sil_hwDuty(void)
+{
+    return sil_pwmDuty();
+}
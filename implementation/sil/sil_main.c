@@ -0,0 +1,227 @@
+/**
+ *
+ * File name:           sil_main.c
+ * File description:    File containing the entry point of the
+ *                      software-in-the-loop host build.
+ *
+ *                      The unmodified firmware main() runs on the main
+ *                      thread. A simulation thread advances the plant and
+ *                      the peripherals in fixed steps, paced against host
+ *                      time, and raises the firmware interrupts.
+ *
+ *                      Usage: sil [--speedup N] [--duration S] [--load NM]
+ *                                 [--inertia KGM2] [--step US] [--stdio]
+ *                                 [--trace FILE] [--no-lockstep]
+ *
+ *                      - The HMI UART is a pseudo terminal whose name is
+ *                        printed on start, so the host software (or any
+ *                        terminal program) can attach to it. With --stdio
+ *                        it is stdin/stdout instead.
+ *                      - --trace writes the plant state every 1ms of
+ *                        simulated time as CSV.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#define _GNU_SOURCE
+
+/* System includes */
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Project includes */
+#include "sil.h"
+
+/* Default simulation step, well below the motor electrical time constant */
+#define SIL_STEP_US                 50
+/* Host pacing and trace period, in simulated time */
+#define SIL_PACE_PERIOD_S           1e-3
+
+static double dSilSpeedup = 10;
+static double dSilDuration = 0;
+static double dSilStep = SIL_STEP_US * 1e-6;
+static FILE *fSilTrace = NULL;
+
+/**
+ * Method name:         sil_usage
+ * Method description:  Prints the command line options and exits
+ * Input params:        pcName = Program name
+ * Output params:       n/a
+ */
+static void sil_usage(const char *pcName)
+{
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --speedup N    simulated time runs N times faster than host time (default 10, 0 = unpaced)\n"
+            "  --duration S   stop after S seconds of simulated time (default: run forever)\n"
+            "  --load NM      constant load torque on the motor shaft\n"
+            "  --inertia KGM2 rotor plus load inertia (default %g)\n"
+            "  --step US      plant integration step in microseconds (default %d)\n"
+            "  --stdio        HMI UART on stdin/stdout instead of a pseudo terminal\n"
+            "  --trace FILE   write time,voltage command,current,velocity,angle every 1ms\n"
+            "  --no-lockstep  firmware work between sleeps takes host time instead of none\n",
+            pcName, SIL_MOTOR_INERTIA_KGM2, SIL_STEP_US);
+    exit(2);
+}
+
+/**
+ * Method name:         sil_openPty
+ * Method description:  Creates the pseudo terminal used as the HMI UART
+ * Input params:        n/a
+ * Output params:       int = Master descriptor, non-blocking
+ */
+static int sil_openPty(void)
+{
+    struct termios tTermios;
+    int iMaster, iSlave;
+
+    iMaster = posix_openpt(O_RDWR | O_NOCTTY);
+    if(iMaster < 0 || grantpt(iMaster) || unlockpt(iMaster))
+    {
+        perror("sil: pty");
+        exit(1);
+    }
+
+    /* Raw mode, and keep the slave open so the master does not hang up between clients */
+    iSlave = open(ptsname(iMaster), O_RDWR | O_NOCTTY);
+    if(iSlave < 0 || tcgetattr(iSlave, &tTermios))
+    {
+        perror("sil: pty");
+        exit(1);
+    }
+    cfmakeraw(&tTermios);
+    tcsetattr(iSlave, TCSANOW, &tTermios);
+
+    fcntl(iMaster, F_SETFL, fcntl(iMaster, F_GETFL) | O_NONBLOCK);
+    fprintf(stderr, "sil: HMI UART on %s\n", ptsname(iMaster));
+    return iMaster;
+}
+
+/**
+ * Method name:         sil_simulationThread
+ * Method description:  Advances the simulation, paced against host time
+ * Input params:        pArg = n/a
+ * Output params:       void* = n/a
+ */
+static void *sil_simulationThread(void *pArg)
+{
+    struct timespec tStart, tNow, tSleep;
+    double dTime = 0, dNextPace = SIL_PACE_PERIOD_S, dHost, dLag;
+
+    (void)pArg;
+    clock_gettime(CLOCK_MONOTONIC, &tStart);
+
+    for(;;)
+    {
+        sil_hwStep(dSilStep);
+        dTime += dSilStep;
+
+        if(dTime < dNextPace)
+            continue;
+        dNextPace += SIL_PACE_PERIOD_S;
+
+        if(fSilTrace)
+            fprintf(fSilTrace, "%.4f,%.4f,%.4f,%.4f,%.5f\n", dTime, sil_hwDuty(),
+                    tSilMotor.dCurrent, tSilMotor.dVelocity, tSilMotor.dAngle);
+
+        if(dSilDuration > 0 && dTime >= dSilDuration)
+        {
+            if(fSilTrace)
+                fclose(fSilTrace);
+            fflush(stdout);
+            exit(0);
+        }
+
+        /* Sleep until host time catches up with simulated time */
+        if(dSilSpeedup > 0)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &tNow);
+            dHost = (tNow.tv_sec - tStart.tv_sec) + (tNow.tv_nsec - tStart.tv_nsec)*1e-9;
+            dLag = dTime/dSilSpeedup - dHost;
+            if(dLag > 0)
+            {
+                tSleep.tv_sec = (time_t)dLag;
+                tSleep.tv_nsec = (long)((dLag - tSleep.tv_sec)*1e9);
+                nanosleep(&tSleep, NULL);
+            }
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    pthread_t tThread;
+    bool bStdio = false, bLockstep = true;
+    double dLoad = 0, dInertia = 0;
+    int iRxFd, iTxFd;
+
+    for(int i = 1; i < argc; i++)
+    {
+        if(!strcmp(argv[i], "--stdio"))
+            bStdio = true;
+        else if(!strcmp(argv[i], "--no-lockstep"))
+            bLockstep = false;
+        else if(i + 1 >= argc)
+            sil_usage(argv[0]);
+        else if(!strcmp(argv[i], "--speedup"))
+            dSilSpeedup = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--duration"))
+            dSilDuration = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--load"))
+            dLoad = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--inertia"))
+            dInertia = atof(argv[++i]);
+        else if(!strcmp(argv[i], "--step"))
+            dSilStep = atof(argv[++i]) * 1e-6;
+        else if(!strcmp(argv[i], "--trace"))
+        {
+            fSilTrace = fopen(argv[++i], "w");
+            if(!fSilTrace)
+            {
+                perror("sil: trace");
+                return 1;
+            }
+            fprintf(fSilTrace, "time,duty,current,velocity,angle\n");
+        }
+        else
+            sil_usage(argv[0]);
+    }
+    if(dSilStep <= 0)
+        sil_usage(argv[0]);
+
+    if(bStdio)
+    {
+        iRxFd = STDIN_FILENO;
+        iTxFd = STDOUT_FILENO;
+        fcntl(iRxFd, F_SETFL, fcntl(iRxFd, F_GETFL) | O_NONBLOCK);
+    }
+    else
+        iRxFd = iTxFd = sil_openPty();
+
+    sil_hwInit(iRxFd, iTxFd);
+    sil_hwSetLockstep(bLockstep);
+    tSilMotor.dLoadTorque = dLoad;
+    if(dInertia > 0)
+        tSilMotor.dInertia = dInertia;
+
+    if(pthread_create(&tThread, NULL, sil_simulationThread, NULL))
+    {
+        perror("sil: thread");
+        return 1;
+    }
+
+    return firmware_main();
+}
@@ -0,0 +1,71 @@
+/**
+ *
+ * File name:           sil_motor.c
+ * File description:    File containing the DC motor plant model used by the
+ *                      software-in-the-loop host build.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <math.h>
+
+/* Project includes */
+#include "sil_motor.h"
+
+/**
+ * Method name:         sil_motorInit
+ * Method description:  Loads the default parameters and stops the motor
+ * Input params:        motor = t_SIL_Motor struct
+ * Output params:       n/a
+ */
+void sil_motorInit(t_SIL_Motor *motor)
+{
+    motor->dSupply = SIL_MOTOR_SUPPLY_V;
+    motor->dResistance = SIL_MOTOR_RESISTANCE_OHM;
+    motor->dInductance = SIL_MOTOR_INDUCTANCE_H;
+    motor->dBackEmf = SIL_MOTOR_BACK_EMF_VS;
+    motor->dInertia = SIL_MOTOR_INERTIA_KGM2;
+    motor->dViscous = SIL_MOTOR_VISCOUS_NMS;
+    motor->dCoulomb = SIL_MOTOR_COULOMB_NM;
+    motor->dLoadTorque = 0;
+    motor->dCurrent = 0;
+    motor->dVelocity = 0;
+    motor->dAngle = 0;
+}
+
+/**
+ * Method name:         sil_motorStep
+ * Method description:  Integrates the motor for one time step
+ * Input params:        motor = t_SIL_Motor struct
+ *                      dDuty = Bipolar H-bridge command, -1 (full reverse) to 1 (full ahead)
+ *                      dDt = Time step [s], should be well below L/R
+ * Output params:       n/a
+ */
+void sil_motorStep(t_SIL_Motor *motor, double dDuty, double dDt)
+{
+    double dVoltage = dDuty * motor->dSupply;
+    double dTorque;
+
+    /* Electrical */
+    motor->dCurrent += dDt * (dVoltage - motor->dResistance*motor->dCurrent - motor->dBackEmf*motor->dVelocity) / motor->dInductance;
+
+    /* Mechanical, Coulomb friction holds the rotor until it is overcome */
+    dTorque = motor->dBackEmf*motor->dCurrent - motor->dViscous*motor->dVelocity - motor->dLoadTorque;
+    if((0 == motor->dVelocity) && (fabs(dTorque) <= motor->dCoulomb))
+        return;
+    dTorque -= (motor->dVelocity != 0 ? copysign(motor->dCoulomb, motor->dVelocity) : copysign(motor->dCoulomb, dTorque));
+
+    double dVelocity = motor->dVelocity + dDt * dTorque / motor->dInertia;
+    /* Friction cannot reverse the rotation within a step */
+    if((motor->dVelocity > 0 && dVelocity < 0) || (motor->dVelocity < 0 && dVelocity > 0))
+        dVelocity = 0;
+    motor->dAngle += dDt * 0.5 * (motor->dVelocity + dVelocity);
+    motor->dVelocity = dVelocity;
+}
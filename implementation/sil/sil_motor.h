@@ -0,0 +1,81 @@
+/**
+ *
+ * File name:           sil_motor.h
+ * File description:    File containing the definition of the DC motor plant
+ *                      model used by the software-in-the-loop host build.
+ *
+ *                      - Armature:  L di/dt = V - R i - Ke w
+ *                      - Mechanics: J dw/dt = Kt i - b w - Tc sign(w) - Tload
+ *                      - Kt = Ke (SI units), integrated with explicit Euler.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SIL_MOTOR_H_
+#define SIL_MOTOR_H_
+
+/* Default parameters: 12V motor reaching about 2100RPM with no load, with a */
+/* flywheel giving a mechanical time constant JR/Ke^2 of about 0.5s */
+#define SIL_MOTOR_SUPPLY_V          12.0
+#define SIL_MOTOR_RESISTANCE_OHM    2.5
+#define SIL_MOTOR_INDUCTANCE_H      1.5e-3
+#define SIL_MOTOR_BACK_EMF_VS       0.054
+#define SIL_MOTOR_INERTIA_KGM2      6.0e-4
+#define SIL_MOTOR_VISCOUS_NMS       5.0e-6
+#define SIL_MOTOR_COULOMB_NM        2.0e-3
+
+/**
+ * Type name:           t_SIL_Motor
+ * Method description:  Struct containing parameters and state of the motor
+ * Params:              dSupply:                H-bridge supply voltage [V]
+ *                      dResistance:            Armature resistance [Ohm]
+ *                      dInductance:            Armature inductance [H]
+ *                      dBackEmf:               Back-EMF and torque constant [V.s/rad]
+ *                      dInertia:               Rotor plus load inertia [kg.m2]
+ *                      dViscous:               Viscous friction [N.m.s/rad]
+ *                      dCoulomb:               Coulomb friction [N.m]
+ *                      dLoadTorque:            External load torque [N.m]
+ *                      dCurrent:               Armature current [A]
+ *                      dVelocity:              Angular velocity [rad/s]
+ *                      dAngle:                 Angular position [rad], not wrapped
+ */
+typedef struct
+{
+    double dSupply;
+    double dResistance;
+    double dInductance;
+    double dBackEmf;
+    double dInertia;
+    double dViscous;
+    double dCoulomb;
+    double dLoadTorque;
+    double dCurrent;
+    double dVelocity;
+    double dAngle;
+} t_SIL_Motor;
+
+/**
+ * Method name:         sil_motorInit
+ * Method description:  Loads the default parameters and stops the motor
+ * Input params:        motor = t_SIL_Motor struct
+ * Output params:       n/a
+ */
+void sil_motorInit(t_SIL_Motor *motor);
+
+/**
+ * Method name:         sil_motorStep
+ * Method description:  Integrates the motor for one time step
+ * Input params:        motor = t_SIL_Motor struct
+ *                      dDuty = Bipolar H-bridge command, -1 (full reverse) to 1 (full ahead)
+ *                      dDt = Time step [s], should be well below L/R
+ * Output params:       n/a
+ */
+void sil_motorStep(t_SIL_Motor *motor, double dDuty, double dDt);
+
+#endif /* SIL_MOTOR_H_ */
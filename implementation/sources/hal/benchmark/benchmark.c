@@ -0,0 +1,246 @@
+/**
+ *
+ * File name:           benchmark.c
+ * File description:    File containing the methods for on-target
+ *                      micro-benchmarks of the hot paths.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <stdint.h>
+
+/* Project includes */
+#include "benchmark.h"
+#include "hal/target_definitions.h"
+#include "hal/controller/controller.h"
+#include "hal/driver/driver.h"
+#include "hal/filter/filter.h"
+#include "hal/profiler/profiler.h"
+#include "hal/serial/serial.h"
+
+/* Velocity loop gains and operating point (rad/s) of the controller benchmark */
+#define BENCHMARK_PID_KP            17
+#define BENCHMARK_PID_KI            1.2
+#define BENCHMARK_PID_MAX_SUM_ERROR 100
+#define BENCHMARK_PID_REFERENCE     40.0
+#define BENCHMARK_PID_SENSOR        38.5
+/* Biquad of the filter benchmark: 2nd order Butterworth low-pass at a tenth of the sample rate */
+#define BENCHMARK_BIQUAD_B0         0.067455
+#define BENCHMARK_BIQUAD_B1         0.134911
+#define BENCHMARK_BIQUAD_B2         0.067455
+#define BENCHMARK_BIQUAD_A1         1.142980
+#define BENCHMARK_BIQUAD_A2         -0.412802
+#define BENCHMARK_BIQUAD_SHIFT      1
+
+/* Same section in the filter module format */
+static const int32_t iBenchmarkBiquad[FILTER_BIQUAD_COEFFICIENTS] =
+{
+    FILTER_COEFFICIENT(BENCHMARK_BIQUAD_B0, BENCHMARK_BIQUAD_SHIFT),
+    FILTER_COEFFICIENT(BENCHMARK_BIQUAD_B1, BENCHMARK_BIQUAD_SHIFT),
+    FILTER_COEFFICIENT(BENCHMARK_BIQUAD_B2, BENCHMARK_BIQUAD_SHIFT),
+    FILTER_COEFFICIENT(BENCHMARK_BIQUAD_A1, BENCHMARK_BIQUAD_SHIFT),
+    FILTER_COEFFICIENT(BENCHMARK_BIQUAD_A2, BENCHMARK_BIQUAD_SHIFT)
+};
+
+/**
+ * Method name:         benchmark_report
+ * Method description:  Sends the result of a benchmark to the host device
+ * Input params:        pcName = Benchmark name
+ *                      uiReference = Cycles per call of the reference implementation
+ *                      uiOptimized = Cycles per call of the optimized implementation
+ * Output params:       n/a
+ */
+static void benchmark_report(const char *pcName, uint32_t uiReference, uint32_t uiOptimized)
+{
+    serial_flush();
+    serial_printf("# bench %s %u %u\r\n", pcName, uiReference, uiOptimized);
+}
+
+/**
+ * Method name:         benchmark_driver
+ * Method description:  PWM update: percent duty through the TPM HAL against the
+ *                      Q15 command with cached MOD and direct CnV stores.
+ *                      Both rewrite the current command, the motor is not disturbed.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void benchmark_driver()
+{
+    int iCall;
+    uint32_t uiStart, uiCycles, uiReference = UINT32_MAX, uiOptimized = UINT32_MAX;
+    int32_t iCommandQ15 = driver_getDriverQ15();
+    /* Same duty as the current command, as a percentage for the HAL path */
+    int iDutyPercent = (int)(((iCommandQ15 + DRIVER_Q15_ONE)*100)/(2*DRIVER_Q15_ONE));
+
+    for(iCall = 0; iCall < BENCHMARK_ITERATIONS; iCall++)
+    {
+        uiStart = profiler_getTimestamp();
+        driver_setHBridgeDutyCycle(iDutyPercent);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiReference)
+            uiReference = uiCycles;
+
+        uiStart = profiler_getTimestamp();
+        driver_setDriverQ15(iCommandQ15);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiOptimized)
+            uiOptimized = uiCycles;
+    }
+    benchmark_report("driver", uiReference, uiOptimized);
+}
+
+/**
+ * Method name:         benchmark_pid
+ * Method description:  Controller update: double controller_PIDUpdate against
+ *                      controller_PIDUpdateQ16 on the DSP_BACKEND kernel. Both run
+ *                      on private instances with the velocity loop gains.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void benchmark_pid()
+{
+    int iCall;
+    uint32_t uiStart, uiCycles, uiReference = UINT32_MAX, uiOptimized = UINT32_MAX;
+    t_PID_Data pidBenchmark;
+    t_PID_Q16 pidBenchmarkQ16;
+    int32_t iSensorQ16 = CONTROLLER_Q16(BENCHMARK_PID_SENSOR);
+    int32_t iReferenceQ16 = CONTROLLER_Q16(BENCHMARK_PID_REFERENCE);
+
+    controller_initPID(&pidBenchmark);
+    controller_setKp(&pidBenchmark, BENCHMARK_PID_KP);
+    controller_setKi(&pidBenchmark, BENCHMARK_PID_KI);
+    controller_setMaxSumError(&pidBenchmark, BENCHMARK_PID_MAX_SUM_ERROR);
+    controller_setOutputLimits(&pidBenchmark, -MAX_MOTOR_VELOCITY_RAD, MAX_MOTOR_VELOCITY_RAD);
+    controller_initPIDQ16(&pidBenchmarkQ16);
+    controller_setKpQ16(&pidBenchmarkQ16, BENCHMARK_PID_KP);
+    controller_setKiQ16(&pidBenchmarkQ16, BENCHMARK_PID_KI);
+    controller_setMaxSumErrorQ16(&pidBenchmarkQ16, BENCHMARK_PID_MAX_SUM_ERROR);
+    controller_setOutputLimitsQ16(&pidBenchmarkQ16, -MAX_MOTOR_VELOCITY_RAD, MAX_MOTOR_VELOCITY_RAD);
+
+    for(iCall = 0; iCall < BENCHMARK_ITERATIONS; iCall++)
+    {
+        uiStart = profiler_getTimestamp();
+        (void)controller_PIDUpdate(&pidBenchmark, BENCHMARK_PID_SENSOR, BENCHMARK_PID_REFERENCE);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiReference)
+            uiReference = uiCycles;
+
+        uiStart = profiler_getTimestamp();
+        (void)controller_PIDUpdateQ16(&pidBenchmarkQ16, iSensorQ16, iReferenceQ16);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiOptimized)
+            uiOptimized = uiCycles;
+    }
+    benchmark_report("pid", uiReference, uiOptimized);
+}
+
+/**
+ * Method name:         benchmark_biquad
+ * Method description:  One biquad section per sample: double direct form I against
+ *                      filter_biquadQ31 on the DSP_BACKEND kernel, both fed a square wave
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void benchmark_biquad()
+{
+    int iCall;
+    uint32_t uiStart, uiCycles, uiReference = UINT32_MAX, uiOptimized = UINT32_MAX;
+    double dInput, dOutput, dState[FILTER_BIQUAD_STATES] = {0, 0, 0, 0};
+    t_FILTER_Biquad filterBenchmark;
+
+    filter_initBiquad(&filterBenchmark, iBenchmarkBiquad, 1, BENCHMARK_BIQUAD_SHIFT);
+
+    for(iCall = 0; iCall < BENCHMARK_ITERATIONS; iCall++)
+    {
+        dInput = (iCall & 8) ? 0.5 : -0.5;
+
+        uiStart = profiler_getTimestamp();
+        dOutput = BENCHMARK_BIQUAD_B0*dInput + BENCHMARK_BIQUAD_B1*dState[0] + BENCHMARK_BIQUAD_B2*dState[1]
+                + BENCHMARK_BIQUAD_A1*dState[2] + BENCHMARK_BIQUAD_A2*dState[3];
+        dState[1] = dState[0];
+        dState[0] = dInput;
+        dState[3] = dState[2];
+        dState[2] = dOutput;
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiReference)
+            uiReference = uiCycles;
+
+        uiStart = profiler_getTimestamp();
+        (void)filter_biquadQ31(&filterBenchmark, (iCall & 8) ? FILTER_COEFFICIENT(0.5, 0) : FILTER_COEFFICIENT(-0.5, 0));
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiOptimized)
+            uiOptimized = uiCycles;
+    }
+    benchmark_report("biquad", uiReference, uiOptimized);
+}
+
+/**
+ * Method name:         benchmark_filter
+ * Method description:  Filter slot, same 2nd order low-pass: 2-state state-space block
+ *                      against a biquad section, the costs of the two structures
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void benchmark_filter()
+{
+    int iCall;
+    uint32_t uiStart, uiCycles, uiReference = UINT32_MAX, uiOptimized = UINT32_MAX;
+    int32_t iInput;
+    t_FILTER_Data filterStateSpace, filterBiquad;
+
+    filter_initFilter(&filterStateSpace, FILTER_DESIGN_LOWPASS_2ND_SS);
+    filter_initFilter(&filterBiquad, FILTER_DESIGN_LOWPASS_2ND);
+
+    for(iCall = 0; iCall < BENCHMARK_ITERATIONS; iCall++)
+    {
+        iInput = (iCall & 8) ? CONTROLLER_Q16(BENCHMARK_PID_REFERENCE) : CONTROLLER_Q16(BENCHMARK_PID_SENSOR);
+
+        uiStart = profiler_getTimestamp();
+        (void)filter_update(&filterStateSpace, iInput);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiReference)
+            uiReference = uiCycles;
+
+        uiStart = profiler_getTimestamp();
+        (void)filter_update(&filterBiquad, iInput);
+        uiCycles = profiler_getElapsedCycles(uiStart);
+        if(uiCycles < uiOptimized)
+            uiOptimized = uiCycles;
+    }
+    benchmark_report("filter", uiReference, uiOptimized);
+}
+
+/**
+ * Method name:         benchmark_run
+ * Method description:  Runs a benchmark and sends the result to the host device:
+ *                      name, reference and optimized cycles per call
+ * Input params:        iBenchmark = t_BENCHMARK_Id, out of range values are ignored
+ * Output params:       n/a
+ */
+void benchmark_run(int iBenchmark)
+{
+    switch(iBenchmark)
+    {
+        case BENCHMARK_DRIVER:
+            benchmark_driver();
+            break;
+        case BENCHMARK_PID:
+            benchmark_pid();
+            break;
+        case BENCHMARK_BIQUAD:
+            benchmark_biquad();
+            break;
+        case BENCHMARK_FILTER:
+            benchmark_filter();
+            break;
+        default:
+            break;
+    }
+}
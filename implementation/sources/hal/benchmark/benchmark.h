@@ -0,0 +1,49 @@
+/**
+ *
+ * File name:           benchmark.h
+ * File description:    File containing the definition of methods for
+ *                      on-target micro-benchmarks of the hot paths.
+ *
+ *                      - Each benchmark times a reference and an optimized
+ *                        implementation call by call with the SysTick and
+ *                        reports the fastest call of each, so interrupts
+ *                        taken during the run do not skew the result.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_BENCHMARK_H_
+#define SOURCES_BENCHMARK_H_
+
+/* Calls timed per implementation */
+#define BENCHMARK_ITERATIONS        64
+
+/**
+ * Type name:           t_BENCHMARK_Id
+ * Method description:  Available benchmarks, selected by the 'b' HMI command
+ */
+typedef enum
+{
+    BENCHMARK_DRIVER = 0,
+    BENCHMARK_PID,
+    BENCHMARK_BIQUAD,
+    BENCHMARK_FILTER,
+    BENCHMARK_COUNT
+} t_BENCHMARK_Id;
+
+/**
+ * Method name:         benchmark_run
+ * Method description:  Runs a benchmark and sends the result to the host device:
+ *                      name, reference and optimized cycles per call
+ * Input params:        iBenchmark = t_BENCHMARK_Id, out of range values are ignored
+ * Output params:       n/a
+ */
+void benchmark_run(int iBenchmark);
+
+#endif /* SOURCES_BENCHMARK_H_ */
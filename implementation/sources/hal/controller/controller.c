@@ -9,16 +9,166 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       20Jun2016
- * Revision date:       20Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
 /* System includes */
 #include <stdlib.h>
+#include <float.h>
+#include <math.h>
 
 /* Project includes */
 #include "controller.h"
 
+/* Saturation limits of the Q16.16 engine */
+#define CONTROLLER_Q16_MAX          INT32_MAX
+#define CONTROLLER_Q16_MIN          INT32_MIN
+
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+/* Q16.16 to the arm_pid_q31 input format: the Q31 range spans +-2^(15 - shift) = +-2048 */
+#define CONTROLLER_CMSIS_SIGNAL_SHIFT   4
+/* Input and output bounds: three products below 2^28 plus a state below 2^30 never wrap */
+/* the unsaturated accumulation of arm_pid_q31 */
+#define CONTROLLER_CMSIS_MAX_INPUT      (1L << 28)
+#define CONTROLLER_CMSIS_MAX_OUTPUT     (1L << 30)
+/* Gain scaling bound, derived gains up to 2^8 */
+#define CONTROLLER_CMSIS_MAX_GAIN_SHIFT 8
+#endif
+
+/**
+ * Method name:         controller_saturateQ16
+ * Method description:  Saturates a 64-bit intermediate result to the Q16.16 range
+ * Input params:        llValue = Intermediate result
+ * Output params:       int32_t = Saturated value
+ */
+static int32_t controller_saturateQ16(int64_t llValue)
+{
+    if(llValue > CONTROLLER_Q16_MAX)
+        return CONTROLLER_Q16_MAX;
+    if(llValue < CONTROLLER_Q16_MIN)
+        return CONTROLLER_Q16_MIN;
+    return (int32_t)llValue;
+}
+
+#if (DSP_BACKEND == DSP_BACKEND_C)
+/**
+ * Method name:         controller_addQ16
+ * Method description:  Saturating Q16.16 addition
+ * Input params:        iA = First term
+ *                      iB = Second term
+ * Output params:       int32_t = Saturated sum
+ */
+static int32_t controller_addQ16(int32_t iA, int32_t iB)
+{
+    int32_t iSum = (int32_t)((uint32_t)iA + (uint32_t)iB);
+    /* Overflow only if both terms have the same sign and the sum's sign differs */
+    if(((iA ^ iSum) & (iB ^ iSum)) < 0)
+        return (iA < 0) ? CONTROLLER_Q16_MIN : CONTROLLER_Q16_MAX;
+    return iSum;
+}
+
+/**
+ * Method name:         controller_subQ16
+ * Method description:  Saturating Q16.16 subtraction
+ * Input params:        iA = Minuend
+ *                      iB = Subtrahend
+ * Output params:       int32_t = Saturated difference
+ */
+static int32_t controller_subQ16(int32_t iA, int32_t iB)
+{
+    int32_t iDifference = (int32_t)((uint32_t)iA - (uint32_t)iB);
+    /* Overflow only if the terms have different signs and the result's sign differs from iA */
+    if(((iA ^ iB) & (iA ^ iDifference)) < 0)
+        return (iA < 0) ? CONTROLLER_Q16_MIN : CONTROLLER_Q16_MAX;
+    return iDifference;
+}
+#endif
+
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+/**
+ * Method name:         controller_clampCmsis
+ * Method description:  Limits a value to [-llLimit, llLimit]
+ * Input params:        llValue = Value
+ *                      llLimit = Limit, positive
+ * Output params:       q31_t = Limited value
+ */
+static q31_t controller_clampCmsis(int64_t llValue, int64_t llLimit)
+{
+    if(llValue > llLimit)
+        return (q31_t)llLimit;
+    if(llValue < -llLimit)
+        return (q31_t)-llLimit;
+    return (q31_t)llValue;
+}
+
+/**
+ * Method name:         controller_gainToCmsis
+ * Method description:  Converts a Q16.16 gain to Q31 scaled down by 2^iGainShift
+ * Input params:        llGain = Gain in Q16.16
+ *                      iGainShift = Gain scaling
+ * Output params:       q31_t = Gain in Q31
+ */
+static q31_t controller_gainToCmsis(int64_t llGain, int32_t iGainShift)
+{
+    return controller_saturateQ16((llGain << (31 - CONTROLLER_Q16_SHIFT)) >> iGainShift);
+}
+
+/**
+ * Method name:         controller_outputToCmsis
+ * Method description:  Converts a Q16.16 output value to the arm_pid_q31 output format
+ * Input params:        iValue = Value in Q16.16
+ *                      iGainShift = Gain scaling
+ * Output params:       q31_t = Value in the output format, within CONTROLLER_CMSIS_MAX_OUTPUT
+ */
+static q31_t controller_outputToCmsis(int32_t iValue, int32_t iGainShift)
+{
+    return controller_clampCmsis(((int64_t)iValue << CONTROLLER_CMSIS_SIGNAL_SHIFT) >> iGainShift,
+            CONTROLLER_CMSIS_MAX_OUTPUT);
+}
+
+/**
+ * Method name:         controller_configureCmsis
+ * Method description:  Derives the arm_pid_q31 gains and limits from the Q16.16 ones.
+ *                      The gain scaling is the smallest one keeping A0, A1 and A2 below 1.0,
+ *                      the running output is rescaled with it so gain changes do not bump.
+ * Input params:        pidData = t_PID_Q16 struct
+ * Output params:       n/a
+ */
+static void controller_configureCmsis(t_PID_Q16 *pidData)
+{
+    int64_t llA0 = (int64_t)pidData->iKp + pidData->iKi + pidData->iKd;
+    int64_t llA1 = -((int64_t)pidData->iKp + 2*(int64_t)pidData->iKd);
+    int64_t llA2 = pidData->iKd;
+    int64_t llLargest = llabs(llA0);
+    int32_t iGainShift = 0;
+    int64_t llOutput;
+
+    if(llabs(llA1) > llLargest)
+        llLargest = llabs(llA1);
+    if(llabs(llA2) > llLargest)
+        llLargest = llabs(llA2);
+    while((iGainShift < CONTROLLER_CMSIS_MAX_GAIN_SHIFT) && (llLargest >= (CONTROLLER_Q16_ONE << iGainShift)))
+        iGainShift++;
+
+    /* Same output in the new scaling */
+    llOutput = ((int64_t)pidData->tCmsis.state[2] << pidData->iCmsisGainShift) >> iGainShift;
+    pidData->tCmsis.state[2] = controller_clampCmsis(llOutput, CONTROLLER_CMSIS_MAX_OUTPUT);
+    pidData->iCmsisGainShift = iGainShift;
+
+    pidData->tCmsis.A0 = controller_gainToCmsis(llA0, iGainShift);
+    pidData->tCmsis.A1 = controller_gainToCmsis(llA1, iGainShift);
+    pidData->tCmsis.A2 = controller_gainToCmsis(llA2, iGainShift);
+    pidData->tCmsis.Kp = controller_gainToCmsis(pidData->iKp, iGainShift);
+    pidData->tCmsis.Ki = controller_gainToCmsis(pidData->iKi, iGainShift);
+    pidData->tCmsis.Kd = controller_gainToCmsis(pidData->iKd, iGainShift);
+
+    pidData->iCmsisMinOutput = controller_outputToCmsis(pidData->iMinOutput, iGainShift);
+    pidData->iCmsisMaxOutput = controller_outputToCmsis(pidData->iMaxOutput, iGainShift);
+    pidData->iCmsisFeedforward = controller_outputToCmsis(pidData->iFeedforward, iGainShift);
+}
+#endif
+
 /**
  * Method name:         controller_initPID
  * Method description:  Initializes the t_PID_Data with safe values
@@ -33,6 +183,11 @@ void controller_initPID(t_PID_Data *pidData)
     pidData->dSensorPreviousValue = 0;
     pidData->dErrorSum = 0;
     pidData->dMaxSumError = 0;
+    pidData->dMinReference = -DBL_MAX;
+    pidData->dMinOutput = -DBL_MAX;
+    pidData->dMaxOutput = DBL_MAX;
+    pidData->dFeedforward = 0;
+    pidData->pDerivativeFilter = 0;
 }
 
 /**
@@ -47,6 +202,58 @@ void controller_setMaxSumError(t_PID_Data *pidData, double dMaxSumError)
     pidData->dMaxSumError = dMaxSumError;
 }
 
+/**
+ * Method name:         controller_setMinReference
+ * Method description:  Sets the reference below which the controller output is 0
+ * Input params:        pidData = t_PID_Data struct
+ *                      dMinReference = Minimum reference
+ * Output params:       n/a
+ */
+void controller_setMinReference(t_PID_Data *pidData, double dMinReference)
+{
+    pidData->dMinReference = dMinReference;
+}
+
+/**
+ * Method name:         controller_setOutputLimits
+ * Method description:  Sets the saturation of the actuation value. The integration stops
+ *                      while the output is saturated in the direction of the error (anti-windup).
+ * Input params:        pidData = t_PID_Data struct
+ *                      dMinOutput = Lower limit
+ *                      dMaxOutput = Upper limit
+ * Output params:       n/a
+ */
+void controller_setOutputLimits(t_PID_Data *pidData, double dMinOutput, double dMaxOutput)
+{
+    pidData->dMinOutput = dMinOutput;
+    pidData->dMaxOutput = dMaxOutput;
+}
+
+/**
+ * Method name:         controller_setFeedforward
+ * Method description:  Sets the term added to the next actuation values. It is saturated with
+ *                      them, so the anti-windup sees the limit the actuator sees.
+ * Input params:        pidData = t_PID_Data struct
+ *                      dFeedforward = Feedforward, in output units
+ * Output params:       n/a
+ */
+void controller_setFeedforward(t_PID_Data *pidData, double dFeedforward)
+{
+    pidData->dFeedforward = dFeedforward;
+}
+
+/**
+ * Method name:         controller_setDerivativeFilter
+ * Method description:  Sets the filter of the derivative term, which is otherwise a raw first difference
+ * Input params:        pidData = t_PID_Data struct
+ *                      filter = Filter slot, run in Q16.16, 0 for none
+ * Output params:       n/a
+ */
+void controller_setDerivativeFilter(t_PID_Data *pidData, t_FILTER_Data *filter)
+{
+    pidData->pDerivativeFilter = filter;
+}
+
 /**
  * Method name:         controller_setKp
  * Method description:  Sets the Kp
@@ -93,9 +300,9 @@ void controller_setKd(t_PID_Data *pidData, double dDGain)
  */
 double controller_PIDUpdate(t_PID_Data *pidData, double dSensorValue, double dReferenceValue)
 {
-    if(dReferenceValue < 20) return 0;
+    if(dReferenceValue < pidData->dMinReference) return 0;
     double dPterm, dIterm, dDterm;
-    double dError, dDifference, dItemp;
+    double dError, dDifference, dItemp, dPreviousSum, dOutput;
 
     dError = dReferenceValue - dSensorValue;
 
@@ -103,16 +310,306 @@ double controller_PIDUpdate(t_PID_Data *pidData, double dSensorValue, double dRe
     dPterm = pidData->dKp * dError;
 
     /*  Integrative */
+    dPreviousSum = pidData->dErrorSum;
     dItemp = pidData->dErrorSum + dError;
-    if(abs(dItemp) < pidData->dMaxSumError)
+    if(fabs(dItemp) < pidData->dMaxSumError)
         pidData->dErrorSum = dItemp;
     dIterm = pidData->dKi * pidData->dErrorSum;
 
     /*  Derivative  */
     dDifference = pidData->dSensorPreviousValue - dSensorValue;
     pidData->dSensorPreviousValue = dSensorValue;
+    if(pidData->pDerivativeFilter)
+        dDifference = controller_q16ToDouble(filter_update(pidData->pDerivativeFilter, controller_doubleToQ16(dDifference)));
     dDterm = pidData->dKd * dDifference;
 
-    return (dPterm + dIterm + dDterm);
+    /* Saturation, undoing this period's integration if it pushed further into the limit */
+    dOutput = dPterm + dIterm + dDterm + pidData->dFeedforward;
+    if(dOutput > pidData->dMaxOutput)
+    {
+        if(dError > 0)
+            pidData->dErrorSum = dPreviousSum;
+        dOutput = pidData->dMaxOutput;
+    }
+    else if(dOutput < pidData->dMinOutput)
+    {
+        if(dError < 0)
+            pidData->dErrorSum = dPreviousSum;
+        dOutput = pidData->dMinOutput;
+    }
+
+    return dOutput;
 }
 
+
+
+/* Q16.16 fixed-point engine */
+
+/**
+ * Method name:         controller_doubleToQ16
+ * Method description:  Converts a double to Q16.16, saturating out-of-range values
+ * Input params:        dValue = Value to be converted
+ * Output params:       int32_t = Value in Q16.16
+ */
+int32_t controller_doubleToQ16(double dValue)
+{
+    double dScaled = dValue * CONTROLLER_Q16_ONE;
+    if(dScaled >= (double)CONTROLLER_Q16_MAX)
+        return CONTROLLER_Q16_MAX;
+    if(dScaled <= (double)CONTROLLER_Q16_MIN)
+        return CONTROLLER_Q16_MIN;
+    return (int32_t)dScaled;
+}
+
+/**
+ * Method name:         controller_q16ToDouble
+ * Method description:  Converts a Q16.16 value to double
+ * Input params:        iValue = Value in Q16.16
+ * Output params:       double = Converted value
+ */
+double controller_q16ToDouble(int32_t iValue)
+{
+    return (double)iValue / CONTROLLER_Q16_ONE;
+}
+
+/**
+ * Method name:         controller_q16ToInt
+ * Method description:  Converts a Q16.16 value to int, truncating towards zero like a double cast
+ * Input params:        iValue = Value in Q16.16
+ * Output params:       int = Integer part of the value
+ */
+int controller_q16ToInt(int32_t iValue)
+{
+    if(iValue < 0)
+        return -(int)((uint32_t)(-(int64_t)iValue) >> CONTROLLER_Q16_SHIFT);
+    return iValue >> CONTROLLER_Q16_SHIFT;
+}
+
+/**
+ * Method name:         controller_mulQ16
+ * Method description:  Saturating Q16.16 multiplication
+ * Input params:        iA = First factor in Q16.16
+ *                      iB = Second factor in Q16.16
+ * Output params:       int32_t = Product in Q16.16
+ */
+int32_t controller_mulQ16(int32_t iA, int32_t iB)
+{
+    return controller_saturateQ16(((int64_t)iA * iB) >> CONTROLLER_Q16_SHIFT);
+}
+
+/**
+ * Method name:         controller_initPIDQ16
+ * Method description:  Initializes the t_PID_Q16 with safe values
+ * Input params:        pidData = t_PID_Q16 struct
+ * Output params:       n/a
+ */
+void controller_initPIDQ16(t_PID_Q16 *pidData)
+{
+    pidData->iKp = 0;
+    pidData->iKi = 0;
+    pidData->iKd = 0;
+    pidData->iSensorPreviousValue = 0;
+    pidData->iErrorSum = 0;
+    pidData->iMaxSumError = 0;
+    pidData->iMinReference = CONTROLLER_Q16_MIN;
+    pidData->iMinOutput = CONTROLLER_Q16_MIN;
+    pidData->iMaxOutput = CONTROLLER_Q16_MAX;
+    pidData->iFeedforward = 0;
+    pidData->pDerivativeFilter = 0;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    pidData->tCmsis.state[0] = 0;
+    pidData->tCmsis.state[1] = 0;
+    pidData->tCmsis.state[2] = 0;
+    pidData->iCmsisGainShift = 0;
+    controller_configureCmsis(pidData);
+#endif
+}
+
+/**
+ * Method name:         controller_setMaxSumErrorQ16
+ * Method description:  Sets the maximum integrative error
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMaxSumError = Maximum error acceptable
+ * Output params:       n/a
+ */
+void controller_setMaxSumErrorQ16(t_PID_Q16 *pidData, double dMaxSumError)
+{
+    pidData->iMaxSumError = controller_doubleToQ16(dMaxSumError);
+}
+
+/**
+ * Method name:         controller_setMinReferenceQ16
+ * Method description:  Sets the reference below which the controller output is 0
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMinReference = Minimum reference
+ * Output params:       n/a
+ */
+void controller_setMinReferenceQ16(t_PID_Q16 *pidData, double dMinReference)
+{
+    pidData->iMinReference = controller_doubleToQ16(dMinReference);
+}
+
+/**
+ * Method name:         controller_setOutputLimitsQ16
+ * Method description:  Sets the saturation of the actuation value. The integration stops
+ *                      while the output is saturated in the direction of the error (anti-windup).
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMinOutput = Lower limit
+ *                      dMaxOutput = Upper limit
+ * Output params:       n/a
+ */
+void controller_setOutputLimitsQ16(t_PID_Q16 *pidData, double dMinOutput, double dMaxOutput)
+{
+    pidData->iMinOutput = controller_doubleToQ16(dMinOutput);
+    pidData->iMaxOutput = controller_doubleToQ16(dMaxOutput);
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    controller_configureCmsis(pidData);
+#endif
+}
+
+/**
+ * Method name:         controller_setFeedforwardQ16
+ * Method description:  Sets the term added to the next actuation values. It is saturated with
+ *                      them, so the anti-windup sees the limit the actuator sees.
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      iFeedforward = Feedforward in Q16.16, in output units
+ * Output params:       n/a
+ */
+void controller_setFeedforwardQ16(t_PID_Q16 *pidData, int32_t iFeedforward)
+{
+    pidData->iFeedforward = iFeedforward;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    pidData->iCmsisFeedforward = controller_outputToCmsis(iFeedforward, pidData->iCmsisGainShift);
+#endif
+}
+
+/**
+ * Method name:         controller_setDerivativeFilterQ16
+ * Method description:  Sets the filter of the derivative term, which is otherwise a raw first difference.
+ *                      Not used by the CMSIS backend.
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      filter = Filter slot, 0 for none
+ * Output params:       n/a
+ */
+void controller_setDerivativeFilterQ16(t_PID_Q16 *pidData, t_FILTER_Data *filter)
+{
+    pidData->pDerivativeFilter = filter;
+}
+
+/**
+ * Method name:         controller_setKpQ16
+ * Method description:  Sets the Kp
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dPGain = Proportional constant
+ * Output params:       n/a
+ */
+void controller_setKpQ16(t_PID_Q16 *pidData, double dPGain)
+{
+    pidData->iKp = controller_doubleToQ16(dPGain);
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    controller_configureCmsis(pidData);
+#endif
+}
+
+/**
+ * Method name:         controller_setKiQ16
+ * Method description:  Sets the Ki
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dIGain = Integrative constant
+ * Output params:       n/a
+ */
+void controller_setKiQ16(t_PID_Q16 *pidData, double dIGain)
+{
+    pidData->iKi = controller_doubleToQ16(dIGain);
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    controller_configureCmsis(pidData);
+#endif
+}
+
+/**
+ * Method name:         controller_setKdQ16
+ * Method description:  Sets the Kd
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dDGain = Derivative constant
+ * Output params:       n/a
+ */
+void controller_setKdQ16(t_PID_Q16 *pidData, double dDGain)
+{
+    pidData->iKd = controller_doubleToQ16(dDGain);
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    controller_configureCmsis(pidData);
+#endif
+}
+
+/**
+ * Method name:         controller_PIDUpdateQ16
+ * Method description:  Updates the running fixed-point controller and retrieves the actuation value
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      iSensorValue = Value from sensor in Q16.16
+ *                      iReferenceValue = Reference value in Q16.16
+ * Output params:       int32_t = Actuation value in Q16.16
+ */
+int32_t controller_PIDUpdateQ16(t_PID_Q16 *pidData, int32_t iSensorValue, int32_t iReferenceValue)
+{
+    if(iReferenceValue < pidData->iMinReference) return 0;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    int64_t llError = ((int64_t)iReferenceValue - iSensorValue) << CONTROLLER_CMSIS_SIGNAL_SHIFT;
+    int32_t iShift = CONTROLLER_CMSIS_SIGNAL_SHIFT - pidData->iCmsisGainShift;
+    int64_t llOutput;
+    q31_t iOutput;
+
+    llOutput = (int64_t)arm_pid_q31(&pidData->tCmsis, controller_clampCmsis(llError, CONTROLLER_CMSIS_MAX_INPUT)) +
+            pidData->iCmsisFeedforward;
+
+    /* Saturation with the feedforward, the velocity form integrates its own output so limiting it is the anti-windup */
+    if(llOutput > pidData->iCmsisMaxOutput)
+        llOutput = pidData->iCmsisMaxOutput;
+    else if(llOutput < pidData->iCmsisMinOutput)
+        llOutput = pidData->iCmsisMinOutput;
+    iOutput = (q31_t)llOutput;
+    pidData->tCmsis.state[2] = controller_clampCmsis(llOutput - pidData->iCmsisFeedforward, CONTROLLER_CMSIS_MAX_OUTPUT);
+
+    if(iShift >= 0)
+        return iOutput >> iShift;
+    return controller_saturateQ16((int64_t)iOutput << -iShift);
+#else
+    int32_t iPterm, iIterm, iDterm;
+    int32_t iError, iDifference, iItemp, iPreviousSum, iOutput;
+
+    iError = controller_subQ16(iReferenceValue, iSensorValue);
+
+    /* Proportional */
+    iPterm = controller_mulQ16(pidData->iKp, iError);
+
+    /*  Integrative */
+    iPreviousSum = pidData->iErrorSum;
+    iItemp = controller_addQ16(pidData->iErrorSum, iError);
+    if((iItemp < pidData->iMaxSumError) && (iItemp > -pidData->iMaxSumError))
+        pidData->iErrorSum = iItemp;
+    iIterm = controller_mulQ16(pidData->iKi, pidData->iErrorSum);
+
+    /*  Derivative  */
+    iDifference = controller_subQ16(pidData->iSensorPreviousValue, iSensorValue);
+    pidData->iSensorPreviousValue = iSensorValue;
+    if(pidData->pDerivativeFilter)
+        iDifference = filter_update(pidData->pDerivativeFilter, iDifference);
+    iDterm = controller_mulQ16(pidData->iKd, iDifference);
+
+    /* Saturation, undoing this period's integration if it pushed further into the limit */
+    iOutput = controller_addQ16(controller_addQ16(controller_addQ16(iPterm, iIterm), iDterm), pidData->iFeedforward);
+    if(iOutput > pidData->iMaxOutput)
+    {
+        if(iError > 0)
+            pidData->iErrorSum = iPreviousSum;
+        iOutput = pidData->iMaxOutput;
+    }
+    else if(iOutput < pidData->iMinOutput)
+    {
+        if(iError < 0)
+            pidData->iErrorSum = iPreviousSum;
+        iOutput = pidData->iMinOutput;
+    }
+
+    return iOutput;
+#endif
+}
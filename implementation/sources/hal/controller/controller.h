@@ -9,13 +9,33 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       20Jun2016                                       
- * Revision date:       20Jun2016                                       
+ * Revision date:       18Oct2026
  *
  */
 
 #ifndef SOURCES_CONTROLLER_H_
 #define SOURCES_CONTROLLER_H_
 
+/* System includes */
+#include <stdint.h>
+
+/* Project includes */
+#include "hal/target_definitions.h"
+#include "hal/filter/filter.h"
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+#include "arm_math.h"
+#endif
+
+/* Q16.16 fixed-point helpers */
+/* Number of fractional bits */
+#define CONTROLLER_Q16_SHIFT        16
+/* 1.0 in Q16.16 */
+#define CONTROLLER_Q16_ONE          (1L << CONTROLLER_Q16_SHIFT)
+/* Compile-time conversion of a constant to Q16.16, folded by the compiler */
+#define CONTROLLER_Q16(x)           ((int32_t)((x) * CONTROLLER_Q16_ONE))
+/* Conversion of an integer to Q16.16 */
+#define CONTROLLER_INT_TO_Q16(x)    ((int32_t)(x) << CONTROLLER_Q16_SHIFT)
+
 /**
  * Type name:           t_PID_Data
  * Method description:  Struct containing variable for PID controller
@@ -25,6 +45,11 @@
  *                      dSensorPreviousValue:   previous value read by sensor
  *                      dErrorSum:              Summation of previous errors up to dMaxSumError
  *                      dMaxSumError:           Maximum value dErrorSum can reach
+ *                      dMinReference:          References below this value turn the controller off
+ *                      dMinOutput:             Lower saturation of the actuation value
+ *                      dMaxOutput:             Upper saturation of the actuation value
+ *                      dFeedforward:           Added to the actuation value before the saturation
+ *                      pDerivativeFilter:      Filter of the sensor difference of the derivative term, 0 for none
  */
 typedef struct
 {
@@ -34,8 +59,61 @@ typedef struct
     double dSensorPreviousValue;
     double dErrorSum;
     double dMaxSumError;
+    double dMinReference;
+    double dMinOutput;
+    double dMaxOutput;
+    double dFeedforward;
+    t_FILTER_Data *pDerivativeFilter;
 } t_PID_Data;
 
+/**
+ * Type name:           t_PID_Q16
+ * Method description:  Struct containing variables for the Q16.16 fixed-point PID controller.
+ *                      Mirrors t_PID_Data, all arithmetic is saturating integer arithmetic.
+ * Params:              iKp:                    Proportional gain
+ *                      iKi:                    Integrative gain
+ *                      iKd:                    Derivative gain
+ *                      iSensorPreviousValue:   previous value read by sensor
+ *                      iErrorSum:              Summation of previous errors up to iMaxSumError
+ *                      iMaxSumError:           Maximum value iErrorSum can reach
+ *                      iMinReference:          References below this value turn the controller off
+ *                      iMinOutput:             Lower saturation of the actuation value
+ *                      iMaxOutput:             Upper saturation of the actuation value
+ *                      iFeedforward:           Added to the actuation value before the saturation
+ *                      pDerivativeFilter:      Filter of the sensor difference of the derivative term, 0 for none
+ *                      tCmsis:                 arm_pid_q31 instance, gains scaled down by 2^iCmsisGainShift
+ *                      iCmsisGainShift:        Gain scaling, keeps the derived gains A0, A1, A2 below 1.0
+ *                      iCmsisMinOutput:        iMinOutput in the arm_pid_q31 output format
+ *                      iCmsisMaxOutput:        iMaxOutput in the arm_pid_q31 output format
+ *                      iCmsisFeedforward:      iFeedforward in the arm_pid_q31 output format
+ *
+ *                      With the CMSIS backend the controller is the velocity (incremental) form
+ *                      of arm_pid_q31: the output integrates itself, iErrorSum and iMaxSumError
+ *                      are unused, the output limits are the anti-windup, and the derivative
+ *                      acts on the error instead of the sensor value, unfiltered.
+ */
+typedef struct
+{
+    int32_t iKp;
+    int32_t iKi;
+    int32_t iKd;
+    int32_t iSensorPreviousValue;
+    int32_t iErrorSum;
+    int32_t iMaxSumError;
+    int32_t iMinReference;
+    int32_t iMinOutput;
+    int32_t iMaxOutput;
+    int32_t iFeedforward;
+    t_FILTER_Data *pDerivativeFilter;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    arm_pid_instance_q31 tCmsis;
+    int32_t iCmsisGainShift;
+    int32_t iCmsisMinOutput;
+    int32_t iCmsisMaxOutput;
+    int32_t iCmsisFeedforward;
+#endif
+} t_PID_Q16;
+
 
 /**
  * Method name:         controller_initPID
@@ -54,6 +132,45 @@ void controller_initPID(t_PID_Data *pidData);
  */
 void controller_setMaxSumError(t_PID_Data *pidData, double dMaxSumError);
 
+/**
+ * Method name:         controller_setMinReference
+ * Method description:  Sets the reference below which the controller output is 0
+ * Input params:        pidData = t_PID_Data struct
+ *                      dMinReference = Minimum reference
+ * Output params:       n/a
+ */
+void controller_setMinReference(t_PID_Data *pidData, double dMinReference);
+
+/**
+ * Method name:         controller_setOutputLimits
+ * Method description:  Sets the saturation of the actuation value. The integration stops
+ *                      while the output is saturated in the direction of the error (anti-windup).
+ * Input params:        pidData = t_PID_Data struct
+ *                      dMinOutput = Lower limit
+ *                      dMaxOutput = Upper limit
+ * Output params:       n/a
+ */
+void controller_setOutputLimits(t_PID_Data *pidData, double dMinOutput, double dMaxOutput);
+
+/**
+ * Method name:         controller_setFeedforward
+ * Method description:  Sets the term added to the next actuation values. It is saturated with
+ *                      them, so the anti-windup sees the limit the actuator sees.
+ * Input params:        pidData = t_PID_Data struct
+ *                      dFeedforward = Feedforward, in output units
+ * Output params:       n/a
+ */
+void controller_setFeedforward(t_PID_Data *pidData, double dFeedforward);
+
+/**
+ * Method name:         controller_setDerivativeFilter
+ * Method description:  Sets the filter of the derivative term, which is otherwise a raw first difference
+ * Input params:        pidData = t_PID_Data struct
+ *                      filter = Filter slot, run in Q16.16, 0 for none
+ * Output params:       n/a
+ */
+void controller_setDerivativeFilter(t_PID_Data *pidData, t_FILTER_Data *filter);
+
 /**
  * Method name:         controller_setKp
  * Method description:  Sets the Kp
@@ -91,4 +208,134 @@ void controller_setKd(t_PID_Data *pidData, double dDGain);
  */
 double controller_PIDUpdate(t_PID_Data *pidData, double dSensorValue, double dReferenceValue);
 
+
+/* Q16.16 fixed-point engine */
+
+/**
+ * Method name:         controller_doubleToQ16
+ * Method description:  Converts a double to Q16.16, saturating out-of-range values
+ * Input params:        dValue = Value to be converted
+ * Output params:       int32_t = Value in Q16.16
+ */
+int32_t controller_doubleToQ16(double dValue);
+
+/**
+ * Method name:         controller_q16ToDouble
+ * Method description:  Converts a Q16.16 value to double
+ * Input params:        iValue = Value in Q16.16
+ * Output params:       double = Converted value
+ */
+double controller_q16ToDouble(int32_t iValue);
+
+/**
+ * Method name:         controller_q16ToInt
+ * Method description:  Converts a Q16.16 value to int, truncating towards zero like a double cast
+ * Input params:        iValue = Value in Q16.16
+ * Output params:       int = Integer part of the value
+ */
+int controller_q16ToInt(int32_t iValue);
+
+/**
+ * Method name:         controller_mulQ16
+ * Method description:  Saturating Q16.16 multiplication
+ * Input params:        iA = First factor in Q16.16
+ *                      iB = Second factor in Q16.16
+ * Output params:       int32_t = Product in Q16.16
+ */
+int32_t controller_mulQ16(int32_t iA, int32_t iB);
+
+/**
+ * Method name:         controller_initPIDQ16
+ * Method description:  Initializes the t_PID_Q16 with safe values
+ * Input params:        pidData = t_PID_Q16 struct
+ * Output params:       n/a
+ */
+void controller_initPIDQ16(t_PID_Q16 *pidData);
+
+/**
+ * Method name:         controller_setMaxSumErrorQ16
+ * Method description:  Sets the maximum integrative error
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMaxSumError = Maximum error acceptable
+ * Output params:       n/a
+ */
+void controller_setMaxSumErrorQ16(t_PID_Q16 *pidData, double dMaxSumError);
+
+/**
+ * Method name:         controller_setMinReferenceQ16
+ * Method description:  Sets the reference below which the controller output is 0
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMinReference = Minimum reference
+ * Output params:       n/a
+ */
+void controller_setMinReferenceQ16(t_PID_Q16 *pidData, double dMinReference);
+
+/**
+ * Method name:         controller_setOutputLimitsQ16
+ * Method description:  Sets the saturation of the actuation value. The integration stops
+ *                      while the output is saturated in the direction of the error (anti-windup).
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dMinOutput = Lower limit
+ *                      dMaxOutput = Upper limit
+ * Output params:       n/a
+ */
+void controller_setOutputLimitsQ16(t_PID_Q16 *pidData, double dMinOutput, double dMaxOutput);
+
+/**
+ * Method name:         controller_setFeedforwardQ16
+ * Method description:  Sets the term added to the next actuation values. It is saturated with
+ *                      them, so the anti-windup sees the limit the actuator sees.
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      iFeedforward = Feedforward in Q16.16, in output units
+ * Output params:       n/a
+ */
+void controller_setFeedforwardQ16(t_PID_Q16 *pidData, int32_t iFeedforward);
+
+/**
+ * Method name:         controller_setDerivativeFilterQ16
+ * Method description:  Sets the filter of the derivative term, which is otherwise a raw first difference.
+ *                      Not used by the CMSIS backend.
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      filter = Filter slot, 0 for none
+ * Output params:       n/a
+ */
+void controller_setDerivativeFilterQ16(t_PID_Q16 *pidData, t_FILTER_Data *filter);
+
+/**
+ * Method name:         controller_setKpQ16
+ * Method description:  Sets the Kp
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dPGain = Proportional constant
+ * Output params:       n/a
+ */
+void controller_setKpQ16(t_PID_Q16 *pidData, double dPGain);
+
+/**
+ * Method name:         controller_setKiQ16
+ * Method description:  Sets the Ki
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dIGain = Integrative constant
+ * Output params:       n/a
+ */
+void controller_setKiQ16(t_PID_Q16 *pidData, double dIGain);
+
+/**
+ * Method name:         controller_setKdQ16
+ * Method description:  Sets the Kd
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      dDGain = Derivative constant
+ * Output params:       n/a
+ */
+void controller_setKdQ16(t_PID_Q16 *pidData, double dDGain);
+
+/**
+ * Method name:         controller_PIDUpdateQ16
+ * Method description:  Updates the running fixed-point controller and retrieves the actuation value
+ * Input params:        pidData = t_PID_Q16 struct
+ *                      iSensorValue = Value from sensor in Q16.16
+ *                      iReferenceValue = Reference value in Q16.16
+ * Output params:       int32_t = Actuation value in Q16.16
+ */
+int32_t controller_PIDUpdateQ16(t_PID_Q16 *pidData, int32_t iSensorValue, int32_t iReferenceValue);
+
 #endif /* SOURCES_CONTROLLER_H_ */
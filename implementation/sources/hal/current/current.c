@@ -0,0 +1,347 @@
+/**
+ *
+ * File name:           current.c
+ * File description:    File containing the methods for motor current
+ *                      sensing with PWM-triggered ADC conversions and DMA.
+ *
+ *                      - Bus clock 13.3MHz, ADCK = bus/2, 12 bits with
+ *                        4-sample hardware averaging: ~15us per result, so
+ *                        PWM frequencies above ~60kHz skip triggers.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <stdint.h>
+#include "fsl_clock_manager.h"
+#include "fsl_port_hal.h"
+#include "fsl_interrupt_manager.h"
+#include "fsl_tpm_hal.h"
+
+/* Project includes */
+#include "current.h"
+#include "hal/target_definitions.h"
+#include "hal/driver/driver.h"
+#include "hal/controller/controller.h"
+#include "hal/profiler/profiler.h"
+
+/* Defines */
+/* 12-bit single-ended conversions */
+#define CURRENT_ADC_FULL_SCALE      4096
+/* One count in A, Q8.24: VREF/(full scale*sensitivity) */
+#define CURRENT_COUNT_TO_AMP_Q24    ((int32_t)(((int64_t)CURRENT_ADC_VREF_MV << 24)/((int64_t)CURRENT_ADC_FULL_SCALE*CURRENT_SENSE_MV_PER_A)))
+/* log2(CURRENT_RING_SIZE) */
+#define CURRENT_RING_SHIFT          4
+/* Ring in bytes, and its DMOD encoding: 16 bytes << (DMOD - 1) */
+#define CURRENT_RING_BYTES          (2*CURRENT_RING_SIZE)
+#define CURRENT_RING_DMOD           (CURRENT_RING_SHIFT - 2)
+/* Byte count loaded in the DMA channel, about 20s of samples at 25kHz */
+#define CURRENT_DMA_BCR             0xFFFE0U
+/* Sum of a full ring at zero current, before calibration */
+#define CURRENT_DEFAULT_ZERO_SUM    ((CURRENT_SENSE_ZERO_MV*CURRENT_ADC_FULL_SCALE*CURRENT_RING_SIZE)/CURRENT_ADC_VREF_MV)
+
+/* PI gains of the current loop, duty (1.0 = supply across the motor) per A and per loop period. */
+/* Tuned for a 1.5mH, 2.5Ohm armature on 12V, crossing over at ~300Hz: Kp = L.wc/V, Ki = R.wc.T/V */
+/* with T = 1/CURRENT_LOOP_FREQUENCY. The loop runs every whole number of PWM periods, so Ki and */
+/* the error sum bound are rescaled to the actual period, see current_scaleLoop */
+#define CURRENT_LOOP_KP             0.25
+#define CURRENT_LOOP_KI             0.04
+/* Error sum bound, covers the full duty through Ki */
+#define CURRENT_LOOP_MAX_SUM_ERROR  30
+
+/* Global variables: */
+/* DMA destination ring, aligned to its size for the DMOD wrap */
+volatile uint16_t usCurrentRing[CURRENT_RING_SIZE] __attribute__((aligned(CURRENT_RING_BYTES)));
+/* Ring sum at zero current */
+int32_t iCurrentZeroSum = CURRENT_DEFAULT_ZERO_SUM;
+/* Zero offset taken */
+int iCurrentCalibrated = 0;
+/* Filtered current, A in Q16.16 */
+int32_t iCurrentQ16 = 0;
+/* DMA errors */
+volatile uint32_t uiCurrentDmaErrors = 0;
+/* Current loop controller, output is the duty in Q16.16 */
+t_PID_Q16 pidCurrentQ16;
+/* Current loop reference and its limit, A in Q16.16 */
+volatile int32_t iCurrentLoopReferenceQ16 = 0;
+volatile int32_t iCurrentLoopLimitQ16 = (int32_t)(((int64_t)CURRENT_LIMIT_MA << CONTROLLER_Q16_SHIFT)/1000);
+/* Duty added to the current loop output, the back-EMF feedforward */
+volatile int32_t iCurrentLoopFeedforwardQ16 = 0;
+/* PWM periods between current loop runs, and periods left to the next run */
+uint32_t uiCurrentLoopDivider = 1;
+uint32_t uiCurrentLoopCount = 1;
+/* PWM frequency the divider and gains were derived for, 0 before the first run */
+uint32_t uiCurrentLoopPwmFrequency = 0;
+
+/**
+ * Method name:         current_scaleLoop
+ * Method description:  Derives the loop divider from the PWM frequency and rescales Ki and the
+ *                      error sum bound to the resulting period, so the integral keeps its
+ *                      gain per second. The integral term is kept across the change.
+ * Input params:        uiFrequencyHz = PWM frequency
+ * Output params:       n/a
+ */
+static void current_scaleLoop(uint32_t uiFrequencyHz)
+{
+    double dPeriodRatio;
+
+    uiCurrentLoopPwmFrequency = uiFrequencyHz;
+    uiCurrentLoopDivider = uiFrequencyHz/CURRENT_LOOP_FREQUENCY;
+    if(!uiCurrentLoopDivider)
+        uiCurrentLoopDivider = 1;
+
+    /* Actual over nominal loop period */
+    dPeriodRatio = ((double)uiCurrentLoopDivider*CURRENT_LOOP_FREQUENCY)/uiFrequencyHz;
+    pidCurrentQ16.iErrorSum = controller_doubleToQ16(controller_q16ToDouble(pidCurrentQ16.iErrorSum)*
+            controller_q16ToDouble(pidCurrentQ16.iKi)/(CURRENT_LOOP_KI*dPeriodRatio));
+    controller_setKiQ16(&pidCurrentQ16, CURRENT_LOOP_KI*dPeriodRatio);
+    controller_setMaxSumErrorQ16(&pidCurrentQ16, CURRENT_LOOP_MAX_SUM_ERROR/dPeriodRatio);
+}
+
+/**
+ * Method name:         CURRENT_DMA_IRQ_HANDLER
+ * Method description:  DMA transfer complete IRQ handler, restarts the byte count
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void CURRENT_DMA_IRQ_HANDLER()
+{
+    if(CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR & (DMA_DSR_BCR_CE_MASK | DMA_DSR_BCR_BES_MASK | DMA_DSR_BCR_BED_MASK))
+        uiCurrentDmaErrors++;
+    /* Writing DONE clears the status, the destination keeps wrapping in the ring */
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(CURRENT_DMA_BCR);
+}
+
+/**
+ * Method name:         CURRENT_LOOP_IRQ_HANDLER
+ * Method description:  PWM period IRQ handler, runs the current loop every few periods.
+ *                      The newest sample is from the previous period, the one triggered
+ *                      by this overflow is still converting.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void CURRENT_LOOP_IRQ_HANDLER()
+{
+    int32_t iDutyQ16;
+    uint32_t uiFrequencyHz;
+
+    TPM_HAL_ClearTimerOverflowFlag(DRIVER_TPM_BASE);
+    if(--uiCurrentLoopCount)
+        return;
+    /* Follows the switching frequency set with driver_configurePwm, floating point only when it changes */
+    uiFrequencyHz = driver_getFrequency();
+    if(uiFrequencyHz != uiCurrentLoopPwmFrequency)
+        current_scaleLoop(uiFrequencyHz);
+    uiCurrentLoopCount = uiCurrentLoopDivider;
+
+    /* The bridge stays off until current_update has taken the zero offset */
+    if(!iCurrentCalibrated)
+        return;
+
+    profiler_startStage(PROFILER_STAGE_CURRENT_LOOP);
+    /* The PI saturates the duty with the feedforward, its integration stops when the bridge does */
+    controller_setFeedforwardQ16(&pidCurrentQ16, iCurrentLoopFeedforwardQ16);
+    iDutyQ16 = controller_PIDUpdateQ16(&pidCurrentQ16, current_getSampleQ16(), iCurrentLoopReferenceQ16);
+    /* Q16.16 to Q15, full duty is DRIVER_Q15_ONE */
+    driver_setDriverQ15(iDutyQ16 >> 1);
+    profiler_stopStage(PROFILER_STAGE_CURRENT_LOOP);
+}
+
+/**
+ * Method name:         current_calibrateAdc
+ * Method description:  Runs the ADC0 self calibration and loads the gain registers
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static void current_calibrateAdc()
+{
+    uint32_t uiGain;
+
+    /* Software trigger and maximum averaging during calibration */
+    CURRENT_ADC_BASE->SC2 = 0;
+    CURRENT_ADC_BASE->SC3 = ADC_SC3_CAL_MASK | ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(3);
+    while(CURRENT_ADC_BASE->SC3 & ADC_SC3_CAL_MASK);
+    /* On failure the reset gains are kept */
+    if(CURRENT_ADC_BASE->SC3 & ADC_SC3_CALF_MASK)
+        return;
+
+    uiGain = CURRENT_ADC_BASE->CLP0 + CURRENT_ADC_BASE->CLP1 + CURRENT_ADC_BASE->CLP2 +
+             CURRENT_ADC_BASE->CLP3 + CURRENT_ADC_BASE->CLP4 + CURRENT_ADC_BASE->CLPS;
+    CURRENT_ADC_BASE->PG = (uiGain >> 1) | 0x8000U;
+    uiGain = CURRENT_ADC_BASE->CLM0 + CURRENT_ADC_BASE->CLM1 + CURRENT_ADC_BASE->CLM2 +
+             CURRENT_ADC_BASE->CLM3 + CURRENT_ADC_BASE->CLM4 + CURRENT_ADC_BASE->CLMS;
+    CURRENT_ADC_BASE->MG = (uiGain >> 1) | 0x8000U;
+}
+
+/**
+ * Method name:         current_initCurrent
+ * Method description:  Calibrates ADC0 and starts the PWM-triggered conversions into the DMA ring
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void current_initCurrent()
+{
+    /* Analog pin */
+    CLOCK_SYS_EnablePortClock(CURRENT_PORT_INSTANCE);
+    PORT_HAL_SetMuxMode(CURRENT_PORT_BASE, CURRENT_PIN_NUMBER, CURRENT_PORT_ALT);
+
+    CLOCK_SYS_EnableAdcClock(0U);
+    CLOCK_SYS_EnableDmamuxClock(0U);
+    CLOCK_SYS_EnableDmaClock(0U);
+
+    /* ADCK = bus/2, 12 bits, short sample time */
+    CURRENT_ADC_BASE->CFG1 = ADC_CFG1_ADIV(1) | ADC_CFG1_MODE(1);
+    CURRENT_ADC_BASE->CFG2 = 0;
+    current_calibrateAdc();
+    CURRENT_ADC_BASE->SC3 = ADC_SC3_AVGE_MASK | ADC_SC3_AVGS(0);
+
+    /* DMA: one 16-bit result per request, into the ring */
+    CURRENT_DMAMUX_BASE->CHCFG[CURRENT_DMA_CHANNEL] = 0;
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_DONE_MASK;
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].SAR = (uintptr_t)&CURRENT_ADC_BASE->R[0];
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DAR = (uintptr_t)usCurrentRing;
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR = DMA_DSR_BCR_BCR(CURRENT_DMA_BCR);
+    CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DCR = DMA_DCR_EINT_MASK | DMA_DCR_ERQ_MASK | DMA_DCR_CS_MASK |
+            DMA_DCR_SSIZE(2) | DMA_DCR_DINC_MASK | DMA_DCR_DSIZE(2) | DMA_DCR_DMOD(CURRENT_RING_DMOD);
+    CURRENT_DMAMUX_BASE->CHCFG[CURRENT_DMA_CHANNEL] = DMAMUX_CHCFG_ENBL_MASK | DMAMUX_CHCFG_SOURCE(CURRENT_DMAMUX_SOURCE);
+    NVIC_EnableIRQ(CURRENT_DMA_IRQn);
+
+    /* TPM0 overflow triggers conversion A, each result requests the DMA */
+    SIM->SOPT7 = SIM_SOPT7_ADC0ALTTRGEN_MASK | SIM_SOPT7_ADC0TRGSEL(CURRENT_ADC_TRIGGER);
+    CURRENT_ADC_BASE->SC2 = ADC_SC2_ADTRG_MASK | ADC_SC2_DMAEN_MASK;
+    CURRENT_ADC_BASE->SC1[0] = ADC_SC1_ADCH(CURRENT_ADC_CHANNEL);
+
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    /* Current loop, full duty either way */
+    controller_initPIDQ16(&pidCurrentQ16);
+    controller_setKpQ16(&pidCurrentQ16, CURRENT_LOOP_KP);
+    controller_setKiQ16(&pidCurrentQ16, CURRENT_LOOP_KI);
+    controller_setOutputLimitsQ16(&pidCurrentQ16, -1, 1);
+    current_scaleLoop(driver_getFrequency());
+    TPM_HAL_ClearTimerOverflowFlag(DRIVER_TPM_BASE);
+    TPM_HAL_EnableTimerOverflowInt(DRIVER_TPM_BASE);
+    NVIC_SetPriority(CURRENT_LOOP_IRQn, CURRENT_LOOP_IRQ_PRIORITY);
+    NVIC_EnableIRQ(CURRENT_LOOP_IRQn);
+#endif
+}
+
+/**
+ * Method name:         current_update
+ * Method description:  Filters the samples in the ring. Takes the zero offset on the first
+ *                      call with a full ring while the driver is still at zero command.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void current_update()
+{
+    int iSample;
+    int32_t iSum = 0;
+
+    for(iSample = 0; iSample < CURRENT_RING_SIZE; iSample++)
+        iSum += usCurrentRing[iSample];
+
+    if(!iCurrentCalibrated &&
+            ((CURRENT_DMA_BCR - (CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DSR_BCR & DMA_DSR_BCR_BCR_MASK)) >= CURRENT_RING_BYTES))
+    {
+        if(!driver_getDriverQ15())
+            iCurrentZeroSum = iSum;
+        iCurrentCalibrated = 1;
+    }
+
+    /* Mean of the ring, the 1/CURRENT_RING_SIZE folded into the shift */
+    iCurrentQ16 = (int32_t)(((int64_t)(iSum - iCurrentZeroSum)*CURRENT_COUNT_TO_AMP_Q24) >> (8 + CURRENT_RING_SHIFT));
+}
+
+/**
+ * Method name:         current_getCurrentQ16
+ * Method description:  Returns the filtered current, as of the last current_update
+ * Input params:        n/a
+ * Output params:       int32_t = Current in A, Q16.16, positive driving forward
+ */
+int32_t current_getCurrentQ16()
+{
+    return iCurrentQ16;
+}
+
+/**
+ * Method name:         current_getSampleQ16
+ * Method description:  Returns the newest sample, unfiltered
+ * Input params:        n/a
+ * Output params:       int32_t = Current in A, Q16.16, positive driving forward
+ */
+int32_t current_getSampleQ16()
+{
+    /* The DMA writes the next sample at DAR, the newest is just behind it */
+    uint32_t uiNext = (uint32_t)(CURRENT_DMA_BASE->DMA[CURRENT_DMA_CHANNEL].DAR - (uintptr_t)usCurrentRing)/2;
+    int32_t iCounts = usCurrentRing[(uiNext - 1) & (CURRENT_RING_SIZE - 1)];
+
+    return (int32_t)(((int64_t)(iCounts*CURRENT_RING_SIZE - iCurrentZeroSum)*CURRENT_COUNT_TO_AMP_Q24) >> (8 + CURRENT_RING_SHIFT));
+}
+
+/**
+ * Method name:         current_getCurrentMilliamps
+ * Method description:  Returns the filtered current, as of the last current_update
+ * Input params:        n/a
+ * Output params:       int32_t = Current in mA
+ */
+int32_t current_getCurrentMilliamps()
+{
+    return (int32_t)(((int64_t)iCurrentQ16*1000) >> 16);
+}
+
+/**
+ * Method name:         current_setReferenceQ16
+ * Method description:  Sets the reference of the current loop, clamped to the current limit
+ * Input params:        iReferenceQ16 = Current in A, Q16.16
+ * Output params:       n/a
+ */
+void current_setReferenceQ16(int32_t iReferenceQ16)
+{
+    int32_t iLimitQ16 = iCurrentLoopLimitQ16;
+
+    if(iReferenceQ16 > iLimitQ16)
+        iReferenceQ16 = iLimitQ16;
+    else if(iReferenceQ16 < -iLimitQ16)
+        iReferenceQ16 = -iLimitQ16;
+    iCurrentLoopReferenceQ16 = iReferenceQ16;
+}
+
+/**
+ * Method name:         current_setLimitMilliamps
+ * Method description:  Sets the limit of the current loop reference, in both directions
+ * Input params:        iLimit = Current in mA
+ * Output params:       n/a
+ */
+void current_setLimitMilliamps(int32_t iLimit)
+{
+    iCurrentLoopLimitQ16 = (int32_t)(((int64_t)iLimit << CONTROLLER_Q16_SHIFT)/1000);
+}
+
+/**
+ * Method name:         current_setFeedforwardQ16
+ * Method description:  Sets the duty added to the current loop output, saturated with it
+ * Input params:        iDutyQ16 = Duty, full scale is 1.0 in Q16.16
+ * Output params:       n/a
+ */
+void current_setFeedforwardQ16(int32_t iDutyQ16)
+{
+    iCurrentLoopFeedforwardQ16 = iDutyQ16;
+}
+
+/**
+ * Method name:         current_getDmaErrors
+ * Method description:  Returns the number of DMA configuration or bus errors
+ * Input params:        n/a
+ * Output params:       uint32_t = Errors
+ */
+uint32_t current_getDmaErrors()
+{
+    return uiCurrentDmaErrors;
+}
@@ -0,0 +1,126 @@
+/**
+ *
+ * File name:           current.h
+ * File description:    File containing the definition of methods for
+ *                      motor current sensing.
+ *
+ *                      - ADC0 is hardware triggered by the TPM0 overflow,
+ *                        the center of the PWM pulses in center-aligned mode,
+ *                        where the sampled current equals its period average.
+ *                      - Each result is moved by DMA into a RAM ring of
+ *                        CURRENT_RING_SIZE samples, the CPU only services
+ *                        the DMA once the byte count runs out (~20s).
+ *                      - The filtered current is the mean of the ring, an
+ *                        integer number of PWM periods.
+ *                      - In CONTROL_LOOP_CASCADE a PI current loop runs in the
+ *                        TPM0 overflow IRQ on the newest sample, decimated to
+ *                        about CURRENT_LOOP_FREQUENCY, and drives the bridge.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_CURRENT_H_
+#define SOURCES_CURRENT_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Samples in the DMA ring, a power of two up to 128 (DMOD) */
+#define CURRENT_RING_SIZE           16
+
+/**
+ * Method name:         CURRENT_DMA_IRQ_HANDLER
+ * Method description:  DMA transfer complete IRQ handler, restarts the byte count
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void CURRENT_DMA_IRQ_HANDLER();
+
+/**
+ * Method name:         CURRENT_LOOP_IRQ_HANDLER
+ * Method description:  PWM period IRQ handler, runs the current loop every few periods
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void CURRENT_LOOP_IRQ_HANDLER();
+
+/**
+ * Method name:         current_initCurrent
+ * Method description:  Calibrates ADC0 and starts the PWM-triggered conversions into the DMA ring
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void current_initCurrent();
+
+/**
+ * Method name:         current_update
+ * Method description:  Filters the samples in the ring. Takes the zero offset on the first
+ *                      call with a full ring while the driver is still at zero command.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void current_update();
+
+/**
+ * Method name:         current_getCurrentQ16
+ * Method description:  Returns the filtered current, as of the last current_update
+ * Input params:        n/a
+ * Output params:       int32_t = Current in A, Q16.16, positive driving forward
+ */
+int32_t current_getCurrentQ16();
+
+/**
+ * Method name:         current_getSampleQ16
+ * Method description:  Returns the newest sample, unfiltered
+ * Input params:        n/a
+ * Output params:       int32_t = Current in A, Q16.16, positive driving forward
+ */
+int32_t current_getSampleQ16();
+
+/**
+ * Method name:         current_getCurrentMilliamps
+ * Method description:  Returns the filtered current, as of the last current_update
+ * Input params:        n/a
+ * Output params:       int32_t = Current in mA
+ */
+int32_t current_getCurrentMilliamps();
+
+/**
+ * Method name:         current_setReferenceQ16
+ * Method description:  Sets the reference of the current loop, clamped to the current limit
+ * Input params:        iReferenceQ16 = Current in A, Q16.16
+ * Output params:       n/a
+ */
+void current_setReferenceQ16(int32_t iReferenceQ16);
+
+/**
+ * Method name:         current_setLimitMilliamps
+ * Method description:  Sets the limit of the current loop reference, in both directions
+ * Input params:        iLimit = Current in mA
+ * Output params:       n/a
+ */
+void current_setLimitMilliamps(int32_t iLimit);
+
+/**
+ * Method name:         current_setFeedforwardQ16
+ * Method description:  Sets the duty added to the current loop output, saturated with it
+ * Input params:        iDutyQ16 = Duty, full scale is 1.0 in Q16.16
+ * Output params:       n/a
+ */
+void current_setFeedforwardQ16(int32_t iDutyQ16);
+
+/**
+ * Method name:         current_getDmaErrors
+ * Method description:  Returns the number of DMA configuration or bus errors
+ * Input params:        n/a
+ * Output params:       uint32_t = Errors
+ */
+uint32_t current_getDmaErrors();
+
+#endif /* SOURCES_CURRENT_H_ */
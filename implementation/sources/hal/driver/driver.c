@@ -6,6 +6,11 @@
  *                      
  *                      - Driver actuation through driver_setDriver goes from -100 to 100, the
  *                        former being full reverse, and the latter, full steam ahead.
+ *                      - driver_setDriverQ15 takes the same range in Q15 and uses every
+ *                        TPM count (MOD + 1 = 320 steps @ 25kHz) instead of 100 steps.
+ *                        MOD is cached at initialization and CnV written directly.
+ *                      - Edge or center-aligned PWM, both alignment and frequency can
+ *                        be changed at runtime with driver_configurePwm.
  *                      - Driver max freq @ 100kHz.
  *                      - Channel A on HighTrue and Channel B on LowTrue makes
  *                        for a bipolar H-Bridge pair of control signals.
@@ -15,7 +20,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       10Jun2016                                       
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -36,8 +41,69 @@
 /* Nominal switching frequency */
 /* 25kHz */
 #define DRIVER_FREQUENCY            25000
+/* Mode at initialization, center-aligned so TPM0 overflows at the center of the pulses (current sampling) */
+#define DRIVER_PWM_MODE             DRIVER_PWM_CENTER_ALIGNED
 /* Prescaler */
 #define DRIVER_PRESCALER            kTpmDividedBy1
+/* TPM counter clock: OSCERCLK / prescaler */
+#define DRIVER_TPM_CLOCK_HZ         8000000U
+/* CnV is latched when the counter wraps from MOD to 0 (MOD to MOD - 1 in center-aligned mode). */
+/* Both channels are written only when at least this many counts (5 core cycles each @ 8MHz) */
+/* separate the counter from MOD */
+#define DRIVER_SYNC_GUARD_COUNTS    4U
+/* Bound on the wait for the wrap, should the TPM clock be stopped */
+#define DRIVER_SYNC_MAX_POLLS       32
+
+/* Global variables: */
+/* TPM modulus, cached whenever the PWM is configured */
+uint32_t uiDriverMod = 0;
+/* Last command written, in Q15 */
+int32_t iDriverCommandQ15 = 0;
+/* Current PWM configuration */
+t_DRIVER_PwmMode tDriverPwmMode = DRIVER_PWM_MODE;
+uint32_t uiDriverFrequency = DRIVER_FREQUENCY;
+
+/**
+ * Method name:         driver_computeMod
+ * Method description:  Returns the TPM modulus for a PWM mode and frequency
+ * Input params:        tMode = PWM alignment
+ *                      uiFrequencyHz = Switching frequency
+ * Output params:       uint32_t = MOD
+ */
+static uint32_t driver_computeMod(t_DRIVER_PwmMode tMode, uint32_t uiFrequencyHz)
+{
+    /* Center-aligned counts up and down, the period is 2*MOD */
+    if(DRIVER_PWM_CENTER_ALIGNED == tMode)
+        return DRIVER_TPM_CLOCK_HZ/(2*uiFrequencyHz);
+    return DRIVER_TPM_CLOCK_HZ/uiFrequencyHz - 1;
+}
+
+/**
+ * Method name:         driver_computeCnV
+ * Method description:  Returns the channel value for a Q15 command with the cached MOD.
+ *                      The same in both modes: the duty cycle is CnV/MOD.
+ * Input params:        iCommandQ15 = Command in Q15, already saturated
+ * Output params:       uint32_t = CnV
+ */
+static inline uint32_t driver_computeCnV(int32_t iCommandQ15)
+{
+    /* Bipolar: duty = (command + 1)/2, so CnV = MOD*(command + 1)/2, rounded to the nearest count */
+    return (uiDriverMod*(uint32_t)(iCommandQ15 + DRIVER_Q15_ONE) + DRIVER_Q15_ONE) >> 16;
+}
+
+/**
+ * Method name:         driver_waitForSafeUpdate
+ * Method description:  Waits until the counter is far enough from the latch point for the
+ *                      following register stores to land in the same PWM period. Call with interrupts masked.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+static inline void driver_waitForSafeUpdate()
+{
+    int iPolls = DRIVER_SYNC_MAX_POLLS;
+
+    while(((uiDriverMod - TPM_CNT_REG(DRIVER_TPM_BASE)) < DRIVER_SYNC_GUARD_COUNTS) && --iPolls);
+}
 
 /**
  * Method name:         driver_initDriver
@@ -78,7 +144,7 @@ void driver_initDriver()
     /* Configure PWM channels. 50% duty cycle is idle, since the driver is bipolar */
     tpm_pwm_param_t pwmA =
         {
-                .mode = kTpmEdgeAlignedPWM,
+                .mode = (DRIVER_PWM_CENTER_ALIGNED == DRIVER_PWM_MODE) ? kTpmCenterAlignedPWM : kTpmEdgeAlignedPWM,
                 .edgeMode = kTpmHighTrue, /* High true, on when channel B is off */
                 .uFrequencyHZ = DRIVER_FREQUENCY,
                 .uDutyCyclePercent = 50,
@@ -86,7 +152,7 @@ void driver_initDriver()
         };
     tpm_pwm_param_t pwmB =
     {
-            .mode = kTpmEdgeAlignedPWM,
+            .mode = (DRIVER_PWM_CENTER_ALIGNED == DRIVER_PWM_MODE) ? kTpmCenterAlignedPWM : kTpmEdgeAlignedPWM,
             .edgeMode = kTpmLowTrue, /* Low true, on when channel A is off*/
             .uFrequencyHZ = DRIVER_FREQUENCY,
             .uDutyCyclePercent = 50,
@@ -95,6 +161,8 @@ void driver_initDriver()
 
     TPM_DRV_PwmStart(DRIVER_TPM_INSTANCE, &pwmA, DRIVER_CHA_INSTANCE);
     TPM_DRV_PwmStart(DRIVER_TPM_INSTANCE, &pwmB, DRIVER_CHB_INSTANCE);
+    /* Scaling of the Q15 command, computed once */
+    uiDriverMod = TPM_HAL_GetMod(DRIVER_TPM_BASE);
 
     driver_enableDriver();
 
@@ -170,6 +238,126 @@ void driver_setDriver(int input)
         input = -100;
     if(input > 100)
         input = 100;
-    input = (input + 100)/2;
-    driver_setHBridgeDutyCycle(input);
+    driver_setDriverQ15((input*DRIVER_Q15_ONE)/100);
+}
+
+/**
+ * Method name:         driver_setDriverQ15
+ * Method description:  Sets the driver with the full resolution of the TPM, -DRIVER_Q15_ONE being
+ *                      full reverse and DRIVER_Q15_ONE full steam ahead. Out of range commands saturate.
+ * Input params:        iCommandQ15 = Command in Q15
+ * Output params:       n/a
+ */
+void driver_setDriverQ15(int32_t iCommandQ15)
+{
+    uint32_t uiChannelCnV;
+
+    /* Cap out-of-bound input */
+    if(iCommandQ15 < -DRIVER_Q15_ONE)
+        iCommandQ15 = -DRIVER_Q15_ONE;
+    if(iCommandQ15 > DRIVER_Q15_ONE)
+        iCommandQ15 = DRIVER_Q15_ONE;
+
+    /* Both stores must land in the same PWM period, or the bridge sees one half-updated cycle */
+    __disable_irq();
+    iDriverCommandQ15 = iCommandQ15;
+    uiChannelCnV = driver_computeCnV(iCommandQ15);
+    driver_waitForSafeUpdate();
+    TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHA_INSTANCE) = uiChannelCnV;
+    TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHB_INSTANCE) = uiChannelCnV;
+    __enable_irq();
+}
+
+/**
+ * Method name:         driver_getDriverQ15
+ * Method description:  Returns the last command written to the driver
+ * Input params:        n/a
+ * Output params:       int32_t = Command in Q15, saturated
+ */
+int32_t driver_getDriverQ15()
+{
+    return iDriverCommandQ15;
+}
+
+/**
+ * Method name:         driver_configurePwm
+ * Method description:  Changes the PWM alignment and switching frequency without initializing the TPM again.
+ *                      A frequency change alone is latched with the new duty at the next period boundary.
+ *                      An alignment change stops the counter for a few cycles, as CPWMS may only be
+ *                      written while it is stopped.
+ * Input params:        tMode = PWM alignment
+ *                      uiFrequencyHz = Switching frequency, saturated to DRIVER_MIN_FREQUENCY..DRIVER_MAX_FREQUENCY
+ * Output params:       n/a
+ */
+void driver_configurePwm(t_DRIVER_PwmMode tMode, uint32_t uiFrequencyHz)
+{
+    uint32_t uiMod, uiChannelCnV;
+
+    if(uiFrequencyHz < DRIVER_MIN_FREQUENCY)
+        uiFrequencyHz = DRIVER_MIN_FREQUENCY;
+    if(uiFrequencyHz > DRIVER_MAX_FREQUENCY)
+        uiFrequencyHz = DRIVER_MAX_FREQUENCY;
+    uiMod = driver_computeMod(tMode, uiFrequencyHz);
+
+    __disable_irq();
+    if(tMode != tDriverPwmMode)
+    {
+        /* Stop the counter and wait for the TPM clock domain to acknowledge */
+        TPM_HAL_SetClockMode(DRIVER_TPM_BASE, kTpmClockSourceNoneClk);
+        while(kTpmClockSourceNoneClk != TPM_HAL_GetClockMode(DRIVER_TPM_BASE));
+        TPM_HAL_SetCpwms(DRIVER_TPM_BASE, DRIVER_PWM_CENTER_ALIGNED == tMode);
+        TPM_HAL_ClearCounter(DRIVER_TPM_BASE);
+        uiDriverMod = uiMod;
+        uiChannelCnV = driver_computeCnV(iDriverCommandQ15);
+        TPM_HAL_SetMod(DRIVER_TPM_BASE, uiMod);
+        TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHA_INSTANCE) = uiChannelCnV;
+        TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHB_INSTANCE) = uiChannelCnV;
+        TPM_HAL_SetClockMode(DRIVER_TPM_BASE, kTpmClockSourceModuleClk);
+    }
+    else
+    {
+        /* MOD and CnV are latched together, all stores must precede the same boundary */
+        driver_waitForSafeUpdate();
+        uiDriverMod = uiMod;
+        uiChannelCnV = driver_computeCnV(iDriverCommandQ15);
+        TPM_HAL_SetMod(DRIVER_TPM_BASE, uiMod);
+        TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHA_INSTANCE) = uiChannelCnV;
+        TPM_CnV_REG(DRIVER_TPM_BASE, DRIVER_CHB_INSTANCE) = uiChannelCnV;
+    }
+    tDriverPwmMode = tMode;
+    uiDriverFrequency = uiFrequencyHz;
+    __enable_irq();
+}
+
+/**
+ * Method name:         driver_getPwmMode
+ * Method description:  Returns the PWM alignment
+ * Input params:        n/a
+ * Output params:       t_DRIVER_PwmMode = PWM alignment
+ */
+t_DRIVER_PwmMode driver_getPwmMode()
+{
+    return tDriverPwmMode;
+}
+
+/**
+ * Method name:         driver_getFrequency
+ * Method description:  Returns the switching frequency
+ * Input params:        n/a
+ * Output params:       uint32_t = Frequency in Hz, as requested; the period is rounded to whole counts
+ */
+uint32_t driver_getFrequency()
+{
+    return uiDriverFrequency;
+}
+
+/**
+ * Method name:         driver_getResolution
+ * Method description:  Returns the number of distinct duty cycles at the current frequency
+ * Input params:        n/a
+ * Output params:       uint32_t = Duty steps, MOD + 1
+ */
+uint32_t driver_getResolution()
+{
+    return uiDriverMod + 1;
 }
@@ -15,7 +15,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       10Jun2016                                       
- * Revision date:       20Jun2016                                       
+ * Revision date:       18Oct2026
  *
  */
 
@@ -23,6 +23,28 @@
 #ifndef SOURCES_DRIVER_H_
 #define SOURCES_DRIVER_H_
 
+/* System includes */
+#include <stdint.h>
+
+/* Full scale of the Q15 driver command, +1.0 is full ahead and -1.0 full reverse */
+#define DRIVER_Q15_ONE              32768
+
+/* Switching frequency range, in Hz. MOD must fit 16 bits and leave a useful resolution */
+#define DRIVER_MIN_FREQUENCY        1000U
+#define DRIVER_MAX_FREQUENCY        100000U
+
+/**
+ * Type name:           t_DRIVER_PwmMode
+ * Method description:  PWM alignment
+ */
+typedef enum
+{
+    /* Up counting, both edges of channel A and B switch at CnV */
+    DRIVER_PWM_EDGE_ALIGNED = 0,
+    /* Up-down counting, pulses centered on the counter reaching 0. Half the frequency for the same MOD */
+    DRIVER_PWM_CENTER_ALIGNED
+} t_DRIVER_PwmMode;
+
 /**
  * Method name:         driver_initDriver
  * Method description:  Initializes the driver with the load in idle
@@ -79,4 +101,54 @@ void driver_setHBridgeDutyCycle(int uiDutyCyclePercent);
  */
 void driver_setDriver(int input);
 
+/**
+ * Method name:         driver_setDriverQ15
+ * Method description:  Sets the driver with the full resolution of the TPM, -DRIVER_Q15_ONE being
+ *                      full reverse and DRIVER_Q15_ONE full steam ahead. Out of range commands saturate.
+ * Input params:        iCommandQ15 = Command in Q15
+ * Output params:       n/a
+ */
+void driver_setDriverQ15(int32_t iCommandQ15);
+
+/**
+ * Method name:         driver_getDriverQ15
+ * Method description:  Returns the last command written to the driver
+ * Input params:        n/a
+ * Output params:       int32_t = Command in Q15, saturated
+ */
+int32_t driver_getDriverQ15();
+
+/**
+ * Method name:         driver_configurePwm
+ * Method description:  Changes the PWM alignment and switching frequency without initializing the TPM again
+ * Input params:        tMode = PWM alignment
+ *                      uiFrequencyHz = Switching frequency, saturated to DRIVER_MIN_FREQUENCY..DRIVER_MAX_FREQUENCY
+ * Output params:       n/a
+ */
+void driver_configurePwm(t_DRIVER_PwmMode tMode, uint32_t uiFrequencyHz);
+
+/**
+ * Method name:         driver_getPwmMode
+ * Method description:  Returns the PWM alignment
+ * Input params:        n/a
+ * Output params:       t_DRIVER_PwmMode = PWM alignment
+ */
+t_DRIVER_PwmMode driver_getPwmMode();
+
+/**
+ * Method name:         driver_getFrequency
+ * Method description:  Returns the switching frequency
+ * Input params:        n/a
+ * Output params:       uint32_t = Frequency in Hz
+ */
+uint32_t driver_getFrequency();
+
+/**
+ * Method name:         driver_getResolution
+ * Method description:  Returns the number of distinct duty cycles at the current frequency
+ * Input params:        n/a
+ * Output params:       uint32_t = Duty steps, MOD + 1
+ */
+uint32_t driver_getResolution();
+
 #endif /* SOURCES_DRIVER_H_ */
@@ -10,7 +10,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       10Jun2016                                       
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -18,6 +18,8 @@
 /* Project Includes */
 #include "encoder.h"
 #include "hal/target_definitions.h"
+#include "hal/controller/controller.h"
+#include "hal/profiler/profiler.h"
 
 /* System Includes */
 #include "fsl_tpm_hal.h"
@@ -28,20 +30,59 @@
 #include "fsl_interrupt_manager.h"
 
 /* Defines */
-/* Maximum number of pulses to be counted in the defined acquisition period before resetting */
+/* Pulse counter modulus minus one, the counter is free running and differenced */
 #define ENCODER_MAX_PULSE_COUNT     0xFFFF
-/* Encoder pulse count */
-#define ENCODER_PULSE_COUNT         1024
-/* Acquisition period, should be same as cyclic executive period */
-#define ENCODER_ACQ_PERIOD_MS       CYCLIC_EXECUTIVE_PERIOD
+/* Capture timer: 8MHz / 8 = 1MHz, wraps every 65.5ms */
+#define ENCODER_CAPTURE_PRESCALER   kTpmDividedBy8
+#define ENCODER_CAPTURE_MOD         0xFFFF
+/* Acquisition period in ms, should be same as cyclic executive period (in us) */
+#define ENCODER_ACQ_PERIOD_MS       (CYCLIC_EXECUTIVE_PERIOD/1000)
+/* One quadrature count per capture tick (1us) in rad/s, Q16.16: 2*pi*1e6*65536/ENCODER_QUADRATURE_COUNT */
+#define ENCODER_COUNT_PER_TICK_TO_RAD_Q16   100530965LL
+/* Time without edges after which the shaft is considered stopped, in capture ticks */
+#define ENCODER_STANDSTILL_TICKS            100000U
 
 /* Global variables: */
 /* Measured pulses per second */
 uint32_t uiEncoderPulsesPerSecond = 0;
-/* Orientation of quadrature, -1 or 1 */
-int iEncoderDirection = 0;
-/* Angular position, in pulses */
-uint32_t uiEncoderPosition = 0;
+/* Pulse counter value at the previous measurement */
+uint32_t uiEncoderPulseSnapshot = 0;
+/* Orientation of quadrature, -1 or 1, from the last edge */
+volatile int iEncoderDirection = 1;
+/* Angular position in quadrature counts, reset by channel O */
+volatile int32_t iEncoderPosition = 0;
+/* Quadrature counts since initialization, never reset */
+volatile int64_t llEncoderCount = 0;
+/* Quadrature state, (A << 1) | B */
+volatile uint32_t uiEncoderState = 0;
+/* Edges that skipped a quadrature state */
+volatile uint32_t uiEncoderQuadratureErrors = 0;
+/* Capture timer overflows, upper bits of the edge timestamps */
+volatile uint32_t uiEncoderCaptureOverflows = 0;
+/* Timestamp of the last decoded edge, in capture ticks */
+volatile uint32_t uiEncoderEdgeTime = 0;
+
+/* Time of the last measurement, in capture ticks */
+uint32_t uiEncoderSampleTime = 0;
+
+/* M/T estimator: count and timestamp of the last edge of the previous window */
+int64_t llEncoderWindowCount = 0;
+uint32_t uiEncoderWindowEdgeTime = 0;
+/* Estimated angular velocity, rad/s in Q16.16, positive forward */
+int32_t iEncoderVelocityQ16 = 0;
+
+/*
+ * Quadrature decoding table, indexed by (previous state << 2) | new state.
+ * Forward is A leading B: 00 -> 10 -> 11 -> 01 -> 00. Transitions changing
+ * both channels at once cannot be resolved and decode as 0.
+ */
+static const int8_t cEncoderQuadratureTable[16] =
+{
+     0, -1,  1,  0,
+     1,  0,  0, -1,
+    -1,  0,  0,  1,
+     0,  1, -1,  0
+};
 
 /*
  * For ENCODER_ACQ_PERIOD_MS = 10ms: 368 pulses @ 2100RPM; 33 pulses @ 3.2RPM
@@ -57,7 +98,122 @@ uint32_t uiEncoderPosition = 0;
 extern void ENCODER_CHO_IRQ_HANDLER()
 {
     PORT_HAL_ClearPinIntFlag(PORTD, 0);
-    uiEncoderPosition = 0;
+    iEncoderPosition = 0;
+}
+
+/**
+ * Method name:         encoder_readState
+ * Method description:  Reads the quadrature state from the capture pins
+ * Input params:        n/a
+ * Output params:       uint32_t = (A << 1) | B
+ */
+static uint32_t encoder_readState()
+{
+    return (GPIO_HAL_ReadPinInput(ENCODER_CAPA_GPIO_BASE, ENCODER_CAPA_PIN_NUMBER) << 1) |
+            GPIO_HAL_ReadPinInput(ENCODER_CHB_GPIO_BASE, ENCODER_CHB_PIN_NUMBER);
+}
+
+/**
+ * Method name:         encoder_extendCapture
+ * Method description:  Extends a 16-bit capture value to a 32-bit timestamp
+ * Input params:        uiCapture = Channel value
+ *                      bOverflow = Overflow flag, read after the channel value
+ * Output params:       uint32_t = Timestamp in capture ticks
+ */
+static uint32_t encoder_extendCapture(uint32_t uiCapture, bool bOverflow)
+{
+    uint32_t uiOverflows = uiEncoderCaptureOverflows;
+
+    /* A pending overflow and a small value mean the capture happened after the wrap */
+    if(bOverflow && (uiCapture < (ENCODER_CAPTURE_MOD + 1)/2))
+        uiOverflows++;
+    return (uiOverflows << 16) | uiCapture;
+}
+
+/**
+ * Method name:         encoder_decodeEdge
+ * Method description:  Applies one edge of channel A or B to the quadrature state
+ * Input params:        uiToggleMask = 2 for an edge on A, 1 for an edge on B
+ *                      uiTime = Timestamp of the edge
+ * Output params:       n/a
+ */
+static void encoder_decodeEdge(uint32_t uiToggleMask, uint32_t uiTime)
+{
+    uint32_t uiState = uiEncoderState ^ uiToggleMask;
+    int iStep = cEncoderQuadratureTable[(uiEncoderState << 2) | uiState];
+
+    iEncoderPosition += iStep;
+    llEncoderCount += iStep;
+    if(iStep)
+    {
+        iEncoderDirection = iStep;
+        uiEncoderEdgeTime = uiTime;
+    }
+    uiEncoderState = uiState;
+}
+
+/**
+ * Method name:         ENCODER_CAPTURE_IRQ_HANDLER
+ * Method description:  Capture IRQ handler, decodes and timestamps every edge of channels A and B
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void ENCODER_CAPTURE_IRQ_HANDLER()
+{
+#if PROFILER_ENCODER_CAPTURE
+    /* Before the register reads, their bus accesses are most of the ISR */
+    profiler_startStage(PROFILER_STAGE_ENCODER_CAPTURE);
+#endif
+    bool bEdgeA = TPM_HAL_GetChnStatus(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL);
+    bool bEdgeB = TPM_HAL_GetChnStatus(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL);
+    uint32_t uiCaptureA = TPM_HAL_GetChnCountVal(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL);
+    uint32_t uiCaptureB = TPM_HAL_GetChnCountVal(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL);
+    /* Read after the channel values, see encoder_extendCapture */
+    bool bOverflow = TPM_HAL_GetTimerOverflowStatus(ENCODER_CAPTURE_TPM_BASE);
+    uint32_t uiTimeA = encoder_extendCapture(uiCaptureA, bOverflow);
+    uint32_t uiTimeB = encoder_extendCapture(uiCaptureB, bOverflow);
+    uint32_t uiState;
+
+    if(bEdgeA)
+        TPM_HAL_ClearChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL);
+    if(bEdgeB)
+        TPM_HAL_ClearChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL);
+
+    if(bEdgeA && bEdgeB)
+    {
+        /* Both edges pending: the capture timestamps give their order */
+        if((int32_t)(uiTimeA - uiTimeB) < 0)
+        {
+            encoder_decodeEdge(2, uiTimeA);
+            encoder_decodeEdge(1, uiTimeB);
+        }
+        else
+        {
+            encoder_decodeEdge(1, uiTimeB);
+            encoder_decodeEdge(2, uiTimeA);
+        }
+    }
+    else if(bEdgeA)
+        encoder_decodeEdge(2, uiTimeA);
+    else if(bEdgeB)
+        encoder_decodeEdge(1, uiTimeB);
+
+    if(bOverflow)
+    {
+        TPM_HAL_ClearTimerOverflowFlag(ENCODER_CAPTURE_TPM_BASE);
+        uiEncoderCaptureOverflows++;
+    }
+
+    /* Pin levels differing from the decoded state mean edges were missed */
+    uiState = encoder_readState();
+    if(uiState != uiEncoderState)
+    {
+        uiEncoderQuadratureErrors++;
+        uiEncoderState = uiState;
+    }
+#if PROFILER_ENCODER_CAPTURE
+    profiler_stopStage(PROFILER_STAGE_ENCODER_CAPTURE);
+#endif
 }
 
 /**
@@ -71,13 +227,18 @@ void encoder_initEncoder()
 
     /* Configure Channel PORTs */
     CLOCK_SYS_EnablePortClock(ENCODER_CHA_PORT_INSTANCE);
+    CLOCK_SYS_EnablePortClock(ENCODER_CAPA_PORT_INSTANCE);
     CLOCK_SYS_EnablePortClock(ENCODER_CHB_PORT_INSTANCE);
     PORT_HAL_SetMuxMode(ENCODER_CHA_PORT_BASE, ENCODER_CHA_PIN_NUMBER, ENCODER_CHA_PORT_ALT);
+    PORT_HAL_SetMuxMode(ENCODER_CAPA_PORT_BASE, ENCODER_CAPA_PIN_NUMBER, ENCODER_CAPA_PORT_ALT);
     PORT_HAL_SetMuxMode(ENCODER_CHB_PORT_BASE, ENCODER_CHB_PIN_NUMBER, ENCODER_CHB_PORT_ALT);
+    GPIO_HAL_SetPinDir(ENCODER_CAPA_GPIO_BASE, ENCODER_CAPA_PIN_NUMBER, kGpioDigitalInput);
+    GPIO_HAL_SetPinDir(ENCODER_CHB_GPIO_BASE, ENCODER_CHB_PIN_NUMBER, kGpioDigitalInput);
 
-    /* Configure external clock source for TPM modules */
+    /* Configure external clock source for the pulse counter */
     SIM_HAL_SetTpmExternalClkPinSelMode(SIM, ENCODER_CHA_TPM_INSTANCE, ENCODER_CHA_FTM_CLKIN);
-    SIM_HAL_SetTpmExternalClkPinSelMode(SIM, ENCODER_CHB_TPM_INSTANCE, ENCODER_CHB_FTM_CLKIN);
+    /* Capture timer runs from the 8MHz external clock, shared with the driver */
+    CLOCK_SYS_SetTpmSrc(ENCODER_CAPTURE_TPM_INSTANCE, kClockTpmSrcOsc0erClk);
 
     /* Will be using USB serial over OpenSDA, must enable Debug Mode */
     tpm_general_config_t config=
@@ -85,20 +246,34 @@ void encoder_initEncoder()
             .isDBGMode = true
     };
     TPM_DRV_Init(ENCODER_CHA_TPM_INSTANCE, &config);
-    TPM_DRV_Init(ENCODER_CHB_TPM_INSTANCE, &config);
+    TPM_DRV_Init(ENCODER_CAPTURE_TPM_INSTANCE, &config);
 
     TPM_HAL_SetClockDiv(ENCODER_CHA_TPM_BASE, kTpmDividedBy1);
-    TPM_HAL_SetClockDiv(ENCODER_CHB_TPM_BASE, kTpmDividedBy1);
+    TPM_HAL_SetClockDiv(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPTURE_PRESCALER);
 
     TPM_HAL_SetMod(ENCODER_CHA_TPM_BASE, ENCODER_MAX_PULSE_COUNT);
-    TPM_HAL_SetMod(ENCODER_CHB_TPM_BASE, ENCODER_MAX_PULSE_COUNT);
+    TPM_HAL_SetMod(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPTURE_MOD);
 
     TPM_HAL_ClearCounter(ENCODER_CHA_TPM_BASE);
-    TPM_HAL_ClearCounter(ENCODER_CHB_TPM_BASE);
-
-    /* Set TPM clock to external for both channels */
+    TPM_HAL_ClearCounter(ENCODER_CAPTURE_TPM_BASE);
+
+    /* Input capture on both edges of A and B */
+    TPM_HAL_SetChnMsnbaElsnbaVal(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL, TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK);
+    TPM_HAL_SetChnMsnbaElsnbaVal(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL, TPM_CnSC_ELSA_MASK | TPM_CnSC_ELSB_MASK);
+    TPM_HAL_ClearChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL);
+    TPM_HAL_ClearChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL);
+    TPM_HAL_EnableChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CAPA_CHANNEL);
+    TPM_HAL_EnableChnInt(ENCODER_CAPTURE_TPM_BASE, ENCODER_CHB_CHANNEL);
+    /* Overflows extend the edge timestamps to 32 bits */
+    TPM_HAL_ClearTimerOverflowFlag(ENCODER_CAPTURE_TPM_BASE);
+    TPM_HAL_EnableTimerOverflowInt(ENCODER_CAPTURE_TPM_BASE);
+    uiEncoderState = encoder_readState();
+
+    /* Pulse counter clocked by channel A, capture timer by the module clock */
     TPM_HAL_SetClockMode(ENCODER_CHA_TPM_BASE, kTpmClockSourceExternalClk);
-    TPM_HAL_SetClockMode(ENCODER_CHB_TPM_BASE, kTpmClockSourceExternalClk);
+    TPM_HAL_SetClockMode(ENCODER_CAPTURE_TPM_BASE, kTpmClockSourceModuleClk);
+    NVIC_SetPriority(ENCODER_CAPTURE_IRQn, ENCODER_CAPTURE_IRQ_PRIORITY);
+    NVIC_EnableIRQ(ENCODER_CAPTURE_IRQn);
 
     /* Set up and enable Channel O interrupt */
     CLOCK_SYS_EnablePortClock(ENCODER_CHO_PORT_INSTANCE);
@@ -118,7 +293,7 @@ void encoder_initEncoder()
 void encoder_enableCounter()
 {
     TPM_HAL_SetClockMode(ENCODER_CHA_TPM_BASE, kTpmClockSourceExternalClk);
-    TPM_HAL_SetClockMode(ENCODER_CHB_TPM_BASE, kTpmClockSourceExternalClk);
+    TPM_HAL_SetClockMode(ENCODER_CAPTURE_TPM_BASE, kTpmClockSourceModuleClk);
 }
 
 /**
@@ -130,20 +305,20 @@ void encoder_enableCounter()
 void encoder_disableCounter()
 {
     TPM_HAL_SetClockMode(ENCODER_CHA_TPM_BASE, kTpmClockSourceNoneClk);
-    TPM_HAL_SetClockMode(ENCODER_CHB_TPM_BASE, kTpmClockSourceNoneClk);
+    TPM_HAL_SetClockMode(ENCODER_CAPTURE_TPM_BASE, kTpmClockSourceNoneClk);
     encoder_resetCounter();
 }
 
 /**
  * Method name:         encoder_resetCounter
- * Method description:  Resets the counter
+ * Method description:  Resets the pulse counter
  * Input params:        n/a
  * Output params:       n/a
  */
 void encoder_resetCounter()
 {
     TPM_HAL_ClearCounter(ENCODER_CHA_TPM_BASE);
-    TPM_HAL_ClearCounter(ENCODER_CHB_TPM_BASE);
+    uiEncoderPulseSnapshot = 0;
 }
 
 /**
@@ -170,16 +345,63 @@ void encoder_disableChOInterrupt()
 
 /**
  * Method name:         encoder_takeMeasurement
- * Method description:  Takes a measurement of speed, direction and position
+ * Method description:  Takes a measurement of speed. Direction and position are kept by the capture IRQ
  * Input params:        n/a
  * Output params:       n/a
  */
 void encoder_takeMeasurement()
 {
-    uiEncoderPulsesPerSecond = (1000*TPM_HAL_GetCounterVal(ENCODER_CHA_TPM_BASE))/ENCODER_ACQ_PERIOD_MS;
-    iEncoderDirection = TPM_HAL_GetCounterVal(ENCODER_CHA_TPM_BASE) > TPM_HAL_GetCounterVal(ENCODER_CHB_TPM_BASE) ? 1 : -1;
-    uiEncoderPosition += TPM_HAL_GetCounterVal(ENCODER_CHA_TPM_BASE);
-    encoder_resetCounter();
+    int64_t llCount;
+    uint32_t uiPulseCount, uiEdgeTime, uiCounter, uiNow, uiTicks, uiBound;
+    int32_t iCounts;
+    uint32_t uiPrimask;
+    bool bOverflow;
+
+    /* Consistent snapshot of the pulse counter and the capture IRQ state, callers may hold the lock already */
+    uiPrimask = __get_PRIMASK();
+    __disable_irq();
+    uiPulseCount = TPM_HAL_GetCounterVal(ENCODER_CHA_TPM_BASE);
+    llCount = llEncoderCount;
+    uiEdgeTime = uiEncoderEdgeTime;
+    /* Separate statements: the flag must be read after the counter, see encoder_extendCapture */
+    uiCounter = TPM_HAL_GetCounterVal(ENCODER_CAPTURE_TPM_BASE);
+    bOverflow = TPM_HAL_GetTimerOverflowStatus(ENCODER_CAPTURE_TPM_BASE);
+    uiNow = encoder_extendCapture(uiCounter, bOverflow);
+    __set_PRIMASK(uiPrimask);
+    uiEncoderSampleTime = uiNow;
+
+    /* The counter is never cleared, so no pulse is lost between read and clear. Modular difference handles the wrap */
+    uiEncoderPulsesPerSecond = (1000*((uiPulseCount - uiEncoderPulseSnapshot) & ENCODER_MAX_PULSE_COUNT))/ENCODER_ACQ_PERIOD_MS;
+    uiEncoderPulseSnapshot = uiPulseCount;
+
+    /*
+     * M/T: counts between the last edges of two windows over the time between
+     * those edges. Resolution no longer depends on the window length.
+     */
+    iCounts = (int32_t)(llCount - llEncoderWindowCount);
+    if(iCounts)
+    {
+        uiTicks = uiEdgeTime - uiEncoderWindowEdgeTime;
+        if(uiTicks)
+            iEncoderVelocityQ16 = (int32_t)(((int64_t)iCounts*ENCODER_COUNT_PER_TICK_TO_RAD_Q16)/uiTicks);
+        llEncoderWindowCount = llCount;
+        uiEncoderWindowEdgeTime = uiEdgeTime;
+    }
+    else
+    {
+        /* No edge in this window: the speed is at most one count since the last one */
+        uiTicks = uiNow - uiEncoderWindowEdgeTime;
+        if(uiTicks > ENCODER_STANDSTILL_TICKS)
+            iEncoderVelocityQ16 = 0;
+        else if(uiTicks)
+        {
+            uiBound = (uint32_t)(ENCODER_COUNT_PER_TICK_TO_RAD_Q16/uiTicks);
+            if(iEncoderVelocityQ16 > (int32_t)uiBound)
+                iEncoderVelocityQ16 = uiBound;
+            else if(iEncoderVelocityQ16 < -(int32_t)uiBound)
+                iEncoderVelocityQ16 = -(int32_t)uiBound;
+        }
+    }
 }
 
 
@@ -193,7 +415,7 @@ void encoder_takeMeasurement()
  */
 double encoder_getAngularPositionDegree()
 {
-    return 360*((double)uiEncoderPosition/ENCODER_PULSE_COUNT);
+    return 360*((double)iEncoderPosition/ENCODER_QUADRATURE_COUNT);
 }
 
 /**
@@ -204,14 +426,66 @@ double encoder_getAngularPositionDegree()
  */
 double encoder_getAngularPositionRad()
 {
-    return CONST_2PI*((double)uiEncoderPosition/ENCODER_PULSE_COUNT);
+    return CONST_2PI*((double)iEncoderPosition/ENCODER_QUADRATURE_COUNT);
+}
+
+/**
+ * Method name:         encoder_getPositionCount
+ * Method description:  Returns the angular position since the last channel O pulse
+ * Input params:        n/a
+ * Output params:       int32_t = Position in quadrature counts, ENCODER_QUADRATURE_COUNT per revolution
+ */
+int32_t encoder_getPositionCount()
+{
+    return iEncoderPosition;
+}
+
+/**
+ * Method name:         encoder_getMultiTurnCount
+ * Method description:  Returns the quadrature counts accumulated since initialization
+ * Input params:        n/a
+ * Output params:       int64_t = Multi-turn position in quadrature counts
+ */
+int64_t encoder_getMultiTurnCount()
+{
+    int64_t llCount;
+    uint32_t uiPrimask;
+
+    /* 64-bit reads are not atomic on the M0+. Restores the lock state, so it can be called with interrupts disabled */
+    uiPrimask = __get_PRIMASK();
+    __disable_irq();
+    llCount = llEncoderCount;
+    __set_PRIMASK(uiPrimask);
+    return llCount;
+}
+
+/**
+ * Method name:         encoder_getQuadratureErrors
+ * Method description:  Returns how many times the decoder had to resynchronize to the pins
+ * Input params:        n/a
+ * Output params:       uint32_t = Number of missed or invalid edges
+ */
+uint32_t encoder_getQuadratureErrors()
+{
+    return uiEncoderQuadratureErrors;
+}
+
+/**
+ * Method name:         encoder_getSampleTime
+ * Method description:  Returns when the last measurement was taken
+ * Input params:        n/a
+ * Output params:       uint32_t = Timestamp in capture ticks (1us), wraps every 71 minutes
+ */
+uint32_t encoder_getSampleTime()
+{
+    return uiEncoderSampleTime;
 }
 
 /**
  * Method name:         encoder_getAngularVelocity
- * Method description:  Returns the angular velocity of the encoder in pulses per second
+ * Method description:  Returns the pulses of channel A counted over the last acquisition period, per second
  * Input params:        n/a
- * Output params:       double = Angular velocity of the encoder in pps
+ * Output params:       double = Angular velocity of the encoder in pps, unsigned
  */
 double encoder_getAngularVelocity()
 {
@@ -222,11 +496,22 @@ double encoder_getAngularVelocity()
  * Method name:         encoder_getAngularVelocityRadPerSec
  * Method description:  Returns the angular velocity of the encoder in Rad/s
  * Input params:        n/a
- * Output params:       double = Angular velocity of the encoder in Rad/s
+ * Output params:       double = Angular velocity of the encoder in Rad/s, positive forward
  */
 double encoder_getAngularVelocityRad()
 {
-    return CONST_2PI*((double)uiEncoderPulsesPerSecond/ENCODER_PULSE_COUNT);
+    return (double)iEncoderVelocityQ16/CONTROLLER_Q16_ONE;
+}
+
+/**
+ * Method name:         encoder_getAngularVelocityRadQ16
+ * Method description:  Returns the angular velocity of the encoder in Rad/s, without floating point math
+ * Input params:        n/a
+ * Output params:       int32_t = Angular velocity of the encoder in Rad/s, Q16.16, positive forward
+ */
+int32_t encoder_getAngularVelocityRadQ16()
+{
+    return iEncoderVelocityQ16;
 }
 
 /**
@@ -237,14 +522,14 @@ double encoder_getAngularVelocityRad()
  */
 double encoder_getAngularVelocityRPM()
 {
-    return 60*((double)uiEncoderPulsesPerSecond/ENCODER_PULSE_COUNT);
+    return 60*encoder_getAngularVelocityRad()/(CONST_2PI);
 }
 
 /**
  * Method name:         encoder_getDirection
  * Method description:  Returns the direction the encoder is spinning
  * Input params:        n/a
- * Output params:       int = Direction (-1 or 1)
+ * Output params:       int = Direction of the last edge (-1 or 1)
  */
 int encoder_getDirection()
 {
@@ -10,7 +10,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       10Jun2016                                       
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -18,6 +18,14 @@
 #ifndef SOURCES_ENCODER_H_
 #define SOURCES_ENCODER_H_
 
+/* System includes */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Encoder pulse count */
+#define ENCODER_PULSE_COUNT         1024
+/* Quadrature counts per revolution, every edge of A and B */
+#define ENCODER_QUADRATURE_COUNT    (4*ENCODER_PULSE_COUNT)
 
 /**
  * Method name:         ENCODER_CHO_IRQ_HANDLER
@@ -27,6 +35,14 @@
  */
 extern void ENCODER_CHO_IRQ_HANDLER();
 
+/**
+ * Method name:         ENCODER_CAPTURE_IRQ_HANDLER
+ * Method description:  Capture IRQ handler, decodes and timestamps every edge of channels A and B
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void ENCODER_CAPTURE_IRQ_HANDLER();
+
 /**
  * Method name:         encoder_initEncoder
  * Method description:  Initializes the encoder for an incremental 3-pin encoder
@@ -53,7 +69,7 @@ void encoder_disableCounter();
 
 /**
  * Method name:         encoder_resetCounter
- * Method description:  Resets the counter
+ * Method description:  Resets the pulse counter
  * Input params:        n/a
  * Output params:       n/a
  */
@@ -77,7 +93,7 @@ void encoder_disableChOInterrupt();
 
 /**
  * Method name:         encoder_takeMeasurement
- * Method description:  Takes a measurement of speed, direction and position
+ * Method description:  Takes a measurement of speed. Direction and position are kept by the capture IRQ
  * Input params:        n/a
  * Output params:       n/a
  */
@@ -102,11 +118,43 @@ double encoder_getAngularPositionDegree();
  */
 double encoder_getAngularPositionRad();
 
+/**
+ * Method name:         encoder_getPositionCount
+ * Method description:  Returns the angular position since the last channel O pulse
+ * Input params:        n/a
+ * Output params:       int32_t = Position in quadrature counts, ENCODER_QUADRATURE_COUNT per revolution
+ */
+int32_t encoder_getPositionCount();
+
+/**
+ * Method name:         encoder_getMultiTurnCount
+ * Method description:  Returns the quadrature counts accumulated since initialization
+ * Input params:        n/a
+ * Output params:       int64_t = Multi-turn position in quadrature counts
+ */
+int64_t encoder_getMultiTurnCount();
+
+/**
+ * Method name:         encoder_getQuadratureErrors
+ * Method description:  Returns how many times the decoder had to resynchronize to the pins
+ * Input params:        n/a
+ * Output params:       uint32_t = Number of missed or invalid edges
+ */
+uint32_t encoder_getQuadratureErrors();
+
+/**
+ * Method name:         encoder_getSampleTime
+ * Method description:  Returns when the last measurement was taken
+ * Input params:        n/a
+ * Output params:       uint32_t = Timestamp in capture ticks (1us), wraps every 71 minutes
+ */
+uint32_t encoder_getSampleTime();
+
 /**
  * Method name:         encoder_getAngularVelocity
- * Method description:  Returns the angular velocity of the encoder in pulses per second
+ * Method description:  Returns the pulses of channel A counted over the last acquisition period, per second
  * Input params:        n/a
- * Output params:       double = Angular velocity of the encoder in pps
+ * Output params:       double = Angular velocity of the encoder in pps, unsigned
  */
 double encoder_getAngularVelocity();
 
@@ -114,10 +162,18 @@ double encoder_getAngularVelocity();
  * Method name:         encoder_getAngularVelocityRadPerSec
  * Method description:  Returns the angular velocity of the encoder in Rad/s
  * Input params:        n/a
- * Output params:       double = Angular velocity of the encoder in Rad/s
+ * Output params:       double = Angular velocity of the encoder in Rad/s, positive forward
  */
 double encoder_getAngularVelocityRad();
 
+/**
+ * Method name:         encoder_getAngularVelocityRadQ16
+ * Method description:  Returns the angular velocity of the encoder in Rad/s, without floating point math
+ * Input params:        n/a
+ * Output params:       int32_t = Angular velocity of the encoder in Rad/s, Q16.16, positive forward
+ */
+int32_t encoder_getAngularVelocityRadQ16();
+
 /**
  * Method name:         encoder_getAngularVelocityRPM
  * Method description:  Returns the angular velocity of the encoder in RPM
@@ -129,7 +185,7 @@ double encoder_getAngularVelocityRPM();
  * Method name:         encoder_getDirection
  * Method description:  Returns the direction the encoder is spinning
  * Input params:        n/a
- * Output params:       int = Direction (-1 or 1)
+ * Output params:       int = Direction of the last edge (-1 or 1)
  */
 int encoder_getDirection();
 
@@ -0,0 +1,225 @@
+/**
+ *
+ * File name:           feedforward.c
+ * File description:    File containing the methods for the model-based
+ *                      velocity feedforward.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <stdlib.h>
+#include <stdint.h>
+
+/* Project includes */
+#include "feedforward.h"
+#include "hal/target_definitions.h"
+#include "hal/controller/controller.h"
+
+/* Control periods per second, the reference changes once per period */
+#define FEEDFORWARD_PERIODS_PER_SECOND  (1000000/(CYCLIC_EXECUTIVE_PERIOD))
+/* Micro-units to units */
+#define FEEDFORWARD_MICRO               1000000
+/* Acceleration bound, steps of an unshaped reference are not fed forward whole, rad/s^2 in Q16.16 */
+#define FEEDFORWARD_MAX_ACCELERATION    CONTROLLER_INT_TO_Q16(1000)
+/* Bound of host parameters, keeps the products within 64 bits */
+#define FEEDFORWARD_MAX_PARAMETER       100000000
+/* Bound of the outputs, keeps their sums with the PID output within 32 bits */
+#define FEEDFORWARD_MAX_OUTPUT          (1L << 30)
+
+/* Parameter table, indexed by t_FEEDFORWARD_Set */
+static const t_FEEDFORWARD_Parameters tFeedforwardTable[FEEDFORWARD_SET_COUNT] =
+{
+    [FEEDFORWARD_SET_NONE] =        {0, 0, 0, 0, 0},
+    /* Ke = Kt = 0.054 V*s, R = 2.5 Ohm, J = 6e-4 kg*m^2, b = 5e-6 N*m*s, Coulomb 2e-3 N*m */
+    [FEEDFORWARD_SET_NOMINAL] =     {37037, 93, 11111, 54000, 2500},
+};
+
+/**
+ * Method name:         feedforward_parameter
+ * Method description:  Bounds a parameter set by the host
+ * Input params:        iValue = Parameter, the sign is ignored
+ * Output params:       int32_t = Parameter within [0, FEEDFORWARD_MAX_PARAMETER]
+ */
+static int32_t feedforward_parameter(int32_t iValue)
+{
+    iValue = abs(iValue);
+    return (iValue > FEEDFORWARD_MAX_PARAMETER) ? FEEDFORWARD_MAX_PARAMETER : iValue;
+}
+
+/**
+ * Method name:         feedforward_saturate
+ * Method description:  Limits a 64-bit intermediate result to [-FEEDFORWARD_MAX_OUTPUT, FEEDFORWARD_MAX_OUTPUT]
+ * Input params:        llValue = Intermediate result
+ * Output params:       int32_t = Limited value
+ */
+static int32_t feedforward_saturate(int64_t llValue)
+{
+    if(llValue > FEEDFORWARD_MAX_OUTPUT)
+        return FEEDFORWARD_MAX_OUTPUT;
+    if(llValue < -FEEDFORWARD_MAX_OUTPUT)
+        return -FEEDFORWARD_MAX_OUTPUT;
+    return (int32_t)llValue;
+}
+
+/**
+ * Method name:         feedforward_initFeedforward
+ * Method description:  Loads a parameter set of the table and clears the outputs
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iSet = t_FEEDFORWARD_Set, out of range values select FEEDFORWARD_SET_NONE
+ * Output params:       n/a
+ */
+void feedforward_initFeedforward(t_FEEDFORWARD_Data *feedforward, int iSet)
+{
+    if((iSet < 0) || (iSet >= FEEDFORWARD_SET_COUNT))
+        iSet = FEEDFORWARD_SET_NONE;
+
+    feedforward->tParameters = tFeedforwardTable[iSet];
+    feedforward_reset(feedforward, 0);
+}
+
+/**
+ * Method name:         feedforward_setStaticFriction
+ * Method description:  Sets the current of the static friction torque
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA
+ * Output params:       n/a
+ */
+void feedforward_setStaticFriction(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps)
+{
+    feedforward->tParameters.iStaticFriction = feedforward_parameter(iMicroamps);
+}
+
+/**
+ * Method name:         feedforward_setViscous
+ * Method description:  Sets the current of the viscous friction torque per velocity
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA per rad/s
+ * Output params:       n/a
+ */
+void feedforward_setViscous(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps)
+{
+    feedforward->tParameters.iViscous = feedforward_parameter(iMicroamps);
+}
+
+/**
+ * Method name:         feedforward_setInertia
+ * Method description:  Sets the current of the inertia torque per acceleration
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA per rad/s^2
+ * Output params:       n/a
+ */
+void feedforward_setInertia(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps)
+{
+    feedforward->tParameters.iInertia = feedforward_parameter(iMicroamps);
+}
+
+/**
+ * Method name:         feedforward_setBackEmf
+ * Method description:  Sets the back-EMF constant
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicrovolts = Back-EMF in uV per rad/s
+ * Output params:       n/a
+ */
+void feedforward_setBackEmf(t_FEEDFORWARD_Data *feedforward, int32_t iMicrovolts)
+{
+    feedforward->tParameters.iBackEmf = feedforward_parameter(iMicrovolts);
+}
+
+/**
+ * Method name:         feedforward_reset
+ * Method description:  Clears the outputs while the controller is off, the next update starts from a reference at rest
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iReferenceQ16 = Velocity reference in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void feedforward_reset(t_FEEDFORWARD_Data *feedforward, int32_t iReferenceQ16)
+{
+    feedforward->iPreviousReference = iReferenceQ16;
+    feedforward->iCurrent = 0;
+    feedforward->iBackEmfVoltage = 0;
+    feedforward->iVoltage = 0;
+}
+
+/**
+ * Method name:         feedforward_update
+ * Method description:  Computes the feedforward of a velocity reference for one control period
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iReferenceQ16 = Velocity reference in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void feedforward_update(t_FEEDFORWARD_Data *feedforward, int32_t iReferenceQ16)
+{
+    const t_FEEDFORWARD_Parameters *parameters = &feedforward->tParameters;
+    int64_t llAcceleration, llCurrent, llBackEmf;
+
+    llAcceleration = ((int64_t)iReferenceQ16 - feedforward->iPreviousReference)*FEEDFORWARD_PERIODS_PER_SECOND;
+    if(llAcceleration > FEEDFORWARD_MAX_ACCELERATION)
+        llAcceleration = FEEDFORWARD_MAX_ACCELERATION;
+    else if(llAcceleration < -FEEDFORWARD_MAX_ACCELERATION)
+        llAcceleration = -FEEDFORWARD_MAX_ACCELERATION;
+    feedforward->iPreviousReference = iReferenceQ16;
+
+    /* Torque as current, in uA and Q16.16 */
+    llCurrent = (int64_t)parameters->iViscous*iReferenceQ16 + parameters->iInertia*llAcceleration;
+    if(iReferenceQ16 > 0)
+        llCurrent += (int64_t)parameters->iStaticFriction*CONTROLLER_Q16_ONE;
+    else if(iReferenceQ16 < 0)
+        llCurrent -= (int64_t)parameters->iStaticFriction*CONTROLLER_Q16_ONE;
+    feedforward->iCurrent = feedforward_saturate(llCurrent/FEEDFORWARD_MICRO);
+
+    /* Voltage, the resistance is in mOhm */
+    llBackEmf = ((int64_t)parameters->iBackEmf*iReferenceQ16)/FEEDFORWARD_MICRO;
+    feedforward->iBackEmfVoltage = feedforward_saturate(llBackEmf);
+    feedforward->iVoltage = feedforward_saturate(llBackEmf + ((int64_t)parameters->iResistance*feedforward->iCurrent)/1000);
+}
+
+/**
+ * Method name:         feedforward_getCurrentQ16
+ * Method description:  Returns the current feedforward, added to the current reference in CONTROL_LOOP_CASCADE
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Current in A, Q16.16
+ */
+int32_t feedforward_getCurrentQ16(const t_FEEDFORWARD_Data *feedforward)
+{
+    return feedforward->iCurrent;
+}
+
+/**
+ * Method name:         feedforward_getBackEmfDutyQ16
+ * Method description:  Returns the back-EMF voltage as duty, added to the current loop output in CONTROL_LOOP_CASCADE
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Duty, full scale is 1.0 in Q16.16
+ */
+int32_t feedforward_getBackEmfDutyQ16(const t_FEEDFORWARD_Data *feedforward)
+{
+    return feedforward_saturate(((int64_t)feedforward->iBackEmfVoltage*1000)/MOTOR_SUPPLY_MV);
+}
+
+/**
+ * Method name:         feedforward_getDutyPercentQ16
+ * Method description:  Returns the whole voltage as duty, added to the PID output in CONTROL_LOOP_VELOCITY
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Duty in percent, Q16.16
+ */
+int32_t feedforward_getDutyPercentQ16(const t_FEEDFORWARD_Data *feedforward)
+{
+    return feedforward_saturate(((int64_t)feedforward->iVoltage*100*1000)/MOTOR_SUPPLY_MV);
+}
+
+/**
+ * Method name:         feedforward_getParameters
+ * Method description:  Returns the motor parameters in use
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       const t_FEEDFORWARD_Parameters* = Parameters
+ */
+const t_FEEDFORWARD_Parameters *feedforward_getParameters(const t_FEEDFORWARD_Data *feedforward)
+{
+    return &feedforward->tParameters;
+}
@@ -0,0 +1,176 @@
+/**
+ *
+ * File name:           feedforward.h
+ * File description:    File containing the definition of methods for the
+ *                      model-based velocity feedforward.
+ *
+ *                      - DC motor model: the current holds the torque of
+ *                        static (Coulomb) friction, viscous friction and
+ *                        inertia, i = Is*sign(w) + Iv*w + Ia*dw/dt, and the
+ *                        voltage is R*i plus the back-EMF Ke*w.
+ *                      - Parameters come from a table of motor sets and can
+ *                        be changed by the host, in integer micro-units.
+ *                      - feedforward_update runs once per control period on
+ *                        the shaped velocity reference, the acceleration is
+ *                        its change over the period.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_FEEDFORWARD_H_
+#define SOURCES_FEEDFORWARD_H_
+
+/* System includes */
+#include <stdint.h>
+
+/**
+ * Type name:           t_FEEDFORWARD_Set
+ * Method description:  Motor parameter sets of the table, selected by the host
+ * Params:              FEEDFORWARD_SET_NONE:       All zero, no feedforward
+ *                      FEEDFORWARD_SET_NOMINAL:    Nominal motor, the parameters of the SIL plant
+ */
+typedef enum
+{
+    FEEDFORWARD_SET_NONE = 0,
+    FEEDFORWARD_SET_NOMINAL,
+    FEEDFORWARD_SET_COUNT
+} t_FEEDFORWARD_Set;
+
+/**
+ * Type name:           t_FEEDFORWARD_Parameters
+ * Method description:  Struct containing the motor parameters, in integer micro-units
+ * Params:              iStaticFriction:        Current of the static friction torque, uA
+ *                      iViscous:               Current of the viscous friction torque, uA per rad/s
+ *                      iInertia:               Current of the inertia torque, uA per rad/s^2
+ *                      iBackEmf:               Back-EMF constant, uV per rad/s
+ *                      iResistance:            Winding and bridge resistance, mOhm
+ */
+typedef struct
+{
+    int32_t iStaticFriction;
+    int32_t iViscous;
+    int32_t iInertia;
+    int32_t iBackEmf;
+    int32_t iResistance;
+} t_FEEDFORWARD_Parameters;
+
+/**
+ * Type name:           t_FEEDFORWARD_Data
+ * Method description:  Struct containing the parameters and outputs of the feedforward
+ * Params:              tParameters:            Motor parameters
+ *                      iPreviousReference:     Reference of the last period, rad/s in Q16.16
+ *                      iCurrent:               Current feedforward, A in Q16.16
+ *                      iBackEmfVoltage:        Back-EMF part of the voltage feedforward, V in Q16.16
+ *                      iVoltage:               Voltage feedforward, V in Q16.16
+ */
+typedef struct
+{
+    t_FEEDFORWARD_Parameters tParameters;
+    int32_t iPreviousReference;
+    int32_t iCurrent;
+    int32_t iBackEmfVoltage;
+    int32_t iVoltage;
+} t_FEEDFORWARD_Data;
+
+/**
+ * Method name:         feedforward_initFeedforward
+ * Method description:  Loads a parameter set of the table and clears the outputs
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iSet = t_FEEDFORWARD_Set, out of range values select FEEDFORWARD_SET_NONE
+ * Output params:       n/a
+ */
+void feedforward_initFeedforward(t_FEEDFORWARD_Data *feedforward, int iSet);
+
+/**
+ * Method name:         feedforward_setStaticFriction
+ * Method description:  Sets the current of the static friction torque
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA
+ * Output params:       n/a
+ */
+void feedforward_setStaticFriction(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps);
+
+/**
+ * Method name:         feedforward_setViscous
+ * Method description:  Sets the current of the viscous friction torque per velocity
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA per rad/s
+ * Output params:       n/a
+ */
+void feedforward_setViscous(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps);
+
+/**
+ * Method name:         feedforward_setInertia
+ * Method description:  Sets the current of the inertia torque per acceleration
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicroamps = Current in uA per rad/s^2
+ * Output params:       n/a
+ */
+void feedforward_setInertia(t_FEEDFORWARD_Data *feedforward, int32_t iMicroamps);
+
+/**
+ * Method name:         feedforward_setBackEmf
+ * Method description:  Sets the back-EMF constant
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iMicrovolts = Back-EMF in uV per rad/s
+ * Output params:       n/a
+ */
+void feedforward_setBackEmf(t_FEEDFORWARD_Data *feedforward, int32_t iMicrovolts);
+
+/**
+ * Method name:         feedforward_reset
+ * Method description:  Clears the outputs while the controller is off, the next update starts from a reference at rest
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iReferenceQ16 = Velocity reference in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void feedforward_reset(t_FEEDFORWARD_Data *feedforward, int32_t iReferenceQ16);
+
+/**
+ * Method name:         feedforward_update
+ * Method description:  Computes the feedforward of a velocity reference for one control period
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ *                      iReferenceQ16 = Velocity reference in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void feedforward_update(t_FEEDFORWARD_Data *feedforward, int32_t iReferenceQ16);
+
+/**
+ * Method name:         feedforward_getCurrentQ16
+ * Method description:  Returns the current feedforward, added to the current reference in CONTROL_LOOP_CASCADE
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Current in A, Q16.16
+ */
+int32_t feedforward_getCurrentQ16(const t_FEEDFORWARD_Data *feedforward);
+
+/**
+ * Method name:         feedforward_getBackEmfDutyQ16
+ * Method description:  Returns the back-EMF voltage as duty, added to the current loop output in CONTROL_LOOP_CASCADE
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Duty, full scale is 1.0 in Q16.16
+ */
+int32_t feedforward_getBackEmfDutyQ16(const t_FEEDFORWARD_Data *feedforward);
+
+/**
+ * Method name:         feedforward_getDutyPercentQ16
+ * Method description:  Returns the whole voltage as duty, added to the PID output in CONTROL_LOOP_VELOCITY
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       int32_t = Duty in percent, Q16.16
+ */
+int32_t feedforward_getDutyPercentQ16(const t_FEEDFORWARD_Data *feedforward);
+
+/**
+ * Method name:         feedforward_getParameters
+ * Method description:  Returns the motor parameters in use
+ * Input params:        feedforward = t_FEEDFORWARD_Data struct
+ * Output params:       const t_FEEDFORWARD_Parameters* = Parameters
+ */
+const t_FEEDFORWARD_Parameters *feedforward_getParameters(const t_FEEDFORWARD_Data *feedforward);
+
+#endif /* SOURCES_FEEDFORWARD_H_ */
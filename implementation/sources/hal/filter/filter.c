@@ -0,0 +1,280 @@
+/**
+ *
+ * File name:           filter.c
+ * File description:    File containing the methods for fixed-point
+ *                      discrete filters.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "filter.h"
+
+/* Coefficient scaling of the table, coefficients up to 2 */
+#define FILTER_TABLE_SHIFT          1
+#define FILTER_TABLE(x)             FILTER_COEFFICIENT(x, FILTER_TABLE_SHIFT)
+
+/* Designs of the coefficient table, by the bilinear transform */
+/* 1st order low-pass: y[n] = a*y[n-1] + (1 - a)*u[n], a = exp(-2*pi/10), the state is y[n-1] */
+static const int32_t iFilterLowpass1st[FILTER_STATE_SPACE_COEFFICIENTS(1)] =
+{
+    FILTER_TABLE(0.533488), FILTER_TABLE(0.466512),
+    FILTER_TABLE(0.533488), FILTER_TABLE(0.466512)
+};
+/* 2nd order Butterworth low-pass */
+static const int32_t iFilterLowpass2nd[FILTER_BIQUAD_COEFFICIENTS] =
+{
+    FILTER_TABLE(0.067455), FILTER_TABLE(0.134911), FILTER_TABLE(0.067455), FILTER_TABLE(1.142981), FILTER_TABLE(-0.412802)
+};
+/* Same in controllable canonical form, B scaled to a unity DC gain of the first state */
+static const int32_t iFilterLowpass2ndSs[FILTER_STATE_SPACE_COEFFICIENTS(2)] =
+{
+    FILTER_TABLE(1.142981), FILTER_TABLE(-0.412802),
+    FILTER_TABLE(1.0), FILTER_TABLE(0),
+    FILTER_TABLE(0.269821), FILTER_TABLE(0),
+    FILTER_TABLE(0.785743), FILTER_TABLE(0.146800),
+    FILTER_TABLE(0.067455)
+};
+/* 4th order Butterworth low-pass, sections of Q = 0.5412 and 1.3066 */
+static const int32_t iFilterLowpass4th[2*FILTER_BIQUAD_COEFFICIENTS] =
+{
+    FILTER_TABLE(0.061885), FILTER_TABLE(0.123770), FILTER_TABLE(0.061885), FILTER_TABLE(1.048600), FILTER_TABLE(-0.296140),
+    FILTER_TABLE(0.077956), FILTER_TABLE(0.155913), FILTER_TABLE(0.077956), FILTER_TABLE(1.320913), FILTER_TABLE(-0.632739)
+};
+/* Notch */
+static const int32_t iFilterNotch[FILTER_BIQUAD_COEFFICIENTS] =
+{
+    FILTER_TABLE(0.8), FILTER_TABLE(0), FILTER_TABLE(0.8), FILTER_TABLE(0), FILTER_TABLE(-0.6)
+};
+
+/* Coefficient table, indexed by t_FILTER_Design */
+static const t_FILTER_Config tFilterTable[FILTER_DESIGN_COUNT] =
+{
+    [FILTER_DESIGN_NONE] =              {FILTER_TYPE_NONE, 0, 0, 0},
+    [FILTER_DESIGN_LOWPASS_1ST] =       {FILTER_TYPE_STATE_SPACE, 1, FILTER_TABLE_SHIFT, iFilterLowpass1st},
+    [FILTER_DESIGN_LOWPASS_2ND] =       {FILTER_TYPE_BIQUAD, 1, FILTER_TABLE_SHIFT, iFilterLowpass2nd},
+    [FILTER_DESIGN_LOWPASS_2ND_SS] =    {FILTER_TYPE_STATE_SPACE, 2, FILTER_TABLE_SHIFT, iFilterLowpass2ndSs},
+    [FILTER_DESIGN_LOWPASS_4TH] =       {FILTER_TYPE_BIQUAD, 2, FILTER_TABLE_SHIFT, iFilterLowpass4th},
+    [FILTER_DESIGN_NOTCH] =             {FILTER_TYPE_BIQUAD, 1, FILTER_TABLE_SHIFT, iFilterNotch},
+};
+
+/**
+ * Method name:         filter_initBiquad
+ * Method description:  Sets the coefficients of a biquad cascade and clears its state
+ * Input params:        filter = t_FILTER_Biquad struct
+ *                      piCoefficients = FILTER_BIQUAD_COEFFICIENTS per section, kept by reference
+ *                      uiSections = Number of sections, limited to FILTER_MAX_SECTIONS
+ *                      ucPostShift = Coefficient scaling
+ * Output params:       n/a
+ */
+void filter_initBiquad(t_FILTER_Biquad *filter, const int32_t *piCoefficients, uint32_t uiSections, uint8_t ucPostShift)
+{
+    if(uiSections > FILTER_MAX_SECTIONS)
+        uiSections = FILTER_MAX_SECTIONS;
+
+    filter->piCoefficients = piCoefficients;
+    filter->uiSections = uiSections;
+    filter->ucPostShift = ucPostShift;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    /* The library only reads the coefficients */
+    filter->tCmsis.numStages = uiSections;
+    filter->tCmsis.pState = filter->iState;
+    filter->tCmsis.pCoeffs = (q31_t *)piCoefficients;
+    filter->tCmsis.postShift = ucPostShift;
+#endif
+    filter_resetBiquad(filter);
+}
+
+/**
+ * Method name:         filter_resetBiquad
+ * Method description:  Clears the state of a biquad cascade
+ * Input params:        filter = t_FILTER_Biquad struct
+ * Output params:       n/a
+ */
+void filter_resetBiquad(t_FILTER_Biquad *filter)
+{
+    int iState;
+
+    for(iState = 0; iState < FILTER_BIQUAD_STATES*FILTER_MAX_SECTIONS; iState++)
+        filter->iState[iState] = 0;
+}
+
+/**
+ * Method name:         filter_biquadQ31
+ * Method description:  Filters one sample. The output is not saturated, the
+ *                      coefficients must leave headroom for the signal gain.
+ * Input params:        filter = t_FILTER_Biquad struct
+ *                      iInput = Sample, Q31
+ * Output params:       int32_t = Filtered sample, Q31
+ */
+int32_t filter_biquadQ31(t_FILTER_Biquad *filter, int32_t iInput)
+{
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    q31_t iOutput;
+
+    arm_biquad_cascade_df1_q31(&filter->tCmsis, &iInput, &iOutput, 1);
+    return iOutput;
+#else
+    const int32_t *piCoefficient = filter->piCoefficients;
+    int32_t *piState = filter->iState;
+    int iShift = 31 - filter->ucPostShift;
+    uint32_t uiSection;
+    int64_t llAccumulator;
+
+    for(uiSection = 0; uiSection < filter->uiSections; uiSection++)
+    {
+        llAccumulator = (int64_t)piCoefficient[0]*iInput;
+        llAccumulator += (int64_t)piCoefficient[1]*piState[0];
+        llAccumulator += (int64_t)piCoefficient[2]*piState[1];
+        llAccumulator += (int64_t)piCoefficient[3]*piState[2];
+        llAccumulator += (int64_t)piCoefficient[4]*piState[3];
+
+        /* x[n-2] = x[n-1], x[n-1] = x[n], y[n-2] = y[n-1] */
+        piState[1] = piState[0];
+        piState[0] = iInput;
+        piState[3] = piState[2];
+        /* Truncated like the CMSIS kernel, y[n] is the input of the next section */
+        iInput = (int32_t)(llAccumulator >> iShift);
+        piState[2] = iInput;
+
+        piCoefficient += FILTER_BIQUAD_COEFFICIENTS;
+        piState += FILTER_BIQUAD_STATES;
+    }
+
+    return iInput;
+#endif
+}
+
+/**
+ * Method name:         filter_initStateSpace
+ * Method description:  Sets the matrices of a state-space block and clears its state
+ * Input params:        filter = t_FILTER_StateSpace struct
+ *                      piCoefficients = FILTER_STATE_SPACE_COEFFICIENTS(uiStates), kept by reference
+ *                      uiStates = Number of states, limited to FILTER_MAX_STATES
+ *                      ucPostShift = Coefficient scaling
+ * Output params:       n/a
+ */
+void filter_initStateSpace(t_FILTER_StateSpace *filter, const int32_t *piCoefficients, uint32_t uiStates, uint8_t ucPostShift)
+{
+    if(uiStates > FILTER_MAX_STATES)
+        uiStates = FILTER_MAX_STATES;
+
+    filter->piCoefficients = piCoefficients;
+    filter->uiStates = uiStates;
+    filter->ucPostShift = ucPostShift;
+    filter_resetStateSpace(filter);
+}
+
+/**
+ * Method name:         filter_resetStateSpace
+ * Method description:  Clears the state of a state-space block
+ * Input params:        filter = t_FILTER_StateSpace struct
+ * Output params:       n/a
+ */
+void filter_resetStateSpace(t_FILTER_StateSpace *filter)
+{
+    int iState;
+
+    for(iState = 0; iState < FILTER_MAX_STATES; iState++)
+        filter->iState[iState] = 0;
+}
+
+/**
+ * Method name:         filter_stateSpaceQ31
+ * Method description:  Filters one sample. Neither the output nor the states are saturated,
+ *                      the matrices must leave headroom for the signal gain.
+ * Input params:        filter = t_FILTER_StateSpace struct
+ *                      iInput = Sample, Q31
+ * Output params:       int32_t = Filtered sample, Q31
+ */
+int32_t filter_stateSpaceQ31(t_FILTER_StateSpace *filter, int32_t iInput)
+{
+    uint32_t uiStates = filter->uiStates;
+    const int32_t *piA = filter->piCoefficients;
+    const int32_t *piB = piA + uiStates*uiStates;
+    const int32_t *piC = piB + uiStates;
+    const int32_t *piD = piC + uiStates;
+    int iShift = 31 - filter->ucPostShift;
+    int32_t iNextState[FILTER_MAX_STATES];
+    uint32_t uiRow, uiColumn;
+    int64_t llAccumulator;
+
+    /* y[n] = C*x[n] + D*u[n] */
+    llAccumulator = (int64_t)*piD*iInput;
+    for(uiColumn = 0; uiColumn < uiStates; uiColumn++)
+        llAccumulator += (int64_t)piC[uiColumn]*filter->iState[uiColumn];
+
+    /* x[n+1] = A*x[n] + B*u[n] */
+    for(uiRow = 0; uiRow < uiStates; uiRow++)
+    {
+        int64_t llState = (int64_t)piB[uiRow]*iInput;
+
+        for(uiColumn = 0; uiColumn < uiStates; uiColumn++)
+            llState += (int64_t)piA[uiRow*uiStates + uiColumn]*filter->iState[uiColumn];
+        iNextState[uiRow] = (int32_t)(llState >> iShift);
+    }
+    for(uiRow = 0; uiRow < uiStates; uiRow++)
+        filter->iState[uiRow] = iNextState[uiRow];
+
+    return (int32_t)(llAccumulator >> iShift);
+}
+
+/**
+ * Method name:         filter_initFilter
+ * Method description:  Loads a design of the coefficient table into a filter slot and clears its state
+ * Input params:        filter = t_FILTER_Data struct
+ *                      iDesign = t_FILTER_Design, out of range values select FILTER_DESIGN_NONE
+ * Output params:       n/a
+ */
+void filter_initFilter(t_FILTER_Data *filter, int iDesign)
+{
+    const t_FILTER_Config *config;
+
+    if((iDesign < 0) || (iDesign >= FILTER_DESIGN_COUNT))
+        iDesign = FILTER_DESIGN_NONE;
+    config = &tFilterTable[iDesign];
+
+    filter->iDesign = iDesign;
+    filter->tType = config->tType;
+    if(FILTER_TYPE_BIQUAD == config->tType)
+        filter_initBiquad(&filter->tBiquad, config->piCoefficients, config->uiOrder, config->ucPostShift);
+    else if(FILTER_TYPE_STATE_SPACE == config->tType)
+        filter_initStateSpace(&filter->tStateSpace, config->piCoefficients, config->uiOrder, config->ucPostShift);
+}
+
+/**
+ * Method name:         filter_getDesign
+ * Method description:  Returns the design running in a filter slot
+ * Input params:        filter = t_FILTER_Data struct
+ * Output params:       int = t_FILTER_Design
+ */
+int filter_getDesign(const t_FILTER_Data *filter)
+{
+    return filter->iDesign;
+}
+
+/**
+ * Method name:         filter_update
+ * Method description:  Filters one sample with the design running in the slot
+ * Input params:        filter = t_FILTER_Data struct
+ *                      iInput = Sample, Q31 or Q16.16
+ * Output params:       int32_t = Filtered sample, same format
+ */
+int32_t filter_update(t_FILTER_Data *filter, int32_t iInput)
+{
+    switch(filter->tType)
+    {
+        case FILTER_TYPE_BIQUAD:
+            return filter_biquadQ31(&filter->tBiquad, iInput);
+        case FILTER_TYPE_STATE_SPACE:
+            return filter_stateSpaceQ31(&filter->tStateSpace, iInput);
+        default:
+            return iInput;
+    }
+}
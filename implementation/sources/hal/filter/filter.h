@@ -0,0 +1,249 @@
+/**
+ *
+ * File name:           filter.h
+ * File description:    File containing the definition of methods for
+ *                      fixed-point discrete filters.
+ *
+ *                      - Biquad cascades in direct form I, Q31 samples and
+ *                        coefficients, 64-bit accumulation, the layout and
+ *                        arithmetic of CMSIS-DSP arm_biquad_cascade_df1_q31.
+ *                      - DSP_BACKEND selects the portable C kernel or the
+ *                        CMSIS-DSP one, both give the same output sample.
+ *                      - State-space blocks of up to FILTER_MAX_STATES states,
+ *                        same formats and arithmetic.
+ *                      - t_FILTER_Data runs any design of the coefficient
+ *                        table (t_FILTER_Design), so a filter slot in the
+ *                        control path is changed with one call.
+ *                      - Filters are linear, Q16.16 signals go through as
+ *                        they are, with the Q31 range as headroom.
+ *
+ *                      Cost per sample, each multiply-accumulate being a
+ *                      32x32->64 bit product (no long multiply on the M0+):
+ *                      - Biquad: 5 per section, 'b2' times one section.
+ *                      - State-space of n states: (n + 1)^2. 'b3' times
+ *                        FILTER_DESIGN_LOWPASS_2ND_SS (9) against the same
+ *                        response as a biquad (5) through filter_update.
+ *                      - filter_update adds a dispatch on the design type.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_FILTER_H_
+#define SOURCES_FILTER_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Project includes */
+#include "hal/target_definitions.h"
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+#include "arm_math.h"
+#endif
+
+/* Largest cascade */
+#define FILTER_MAX_SECTIONS         4
+/* Coefficients per section: b0, b1, b2, a1, a2, for */
+/* y[n] = b0*x[n] + b1*x[n-1] + b2*x[n-2] + a1*y[n-1] + a2*y[n-2] (a1, a2 negated from the usual form) */
+#define FILTER_BIQUAD_COEFFICIENTS  5
+/* State per section: x[n-1], x[n-2], y[n-1], y[n-2] */
+#define FILTER_BIQUAD_STATES        4
+/* Largest state-space block */
+#define FILTER_MAX_STATES           2
+/* Coefficients of a block of n states: A (n x n, row-major), B (n), C (n), D, for */
+/* x[n+1] = A*x[n] + B*u[n], y[n] = C*x[n] + D*u[n] */
+#define FILTER_STATE_SPACE_COEFFICIENTS(n)  (((n) + 1)*((n) + 1))
+/* Compile-time conversion of a coefficient to Q31 scaled down by 2^(postShift), |x| < 2^(postShift) */
+#define FILTER_COEFFICIENT(x, postShift)    ((int32_t)((x) * (2147483648.0 / (1L << (postShift)))))
+
+/**
+ * Type name:           t_FILTER_Biquad
+ * Method description:  Struct containing the coefficients and state of a biquad cascade
+ * Params:              piCoefficients:         FILTER_BIQUAD_COEFFICIENTS per section, Q31 scaled down by 2^ucPostShift
+ *                      iState:                 FILTER_BIQUAD_STATES per section
+ *                      uiSections:             Number of sections, up to FILTER_MAX_SECTIONS
+ *                      ucPostShift:            Coefficient scaling, lets coefficients reach 2^ucPostShift
+ *                      tCmsis:                 arm_biquad_cascade_df1_q31 instance over the same arrays
+ */
+typedef struct
+{
+    const int32_t *piCoefficients;
+    int32_t iState[FILTER_BIQUAD_STATES*FILTER_MAX_SECTIONS];
+    uint32_t uiSections;
+    uint8_t ucPostShift;
+#if (DSP_BACKEND == DSP_BACKEND_CMSIS)
+    arm_biquad_casd_df1_inst_q31 tCmsis;
+#endif
+} t_FILTER_Biquad;
+
+/**
+ * Type name:           t_FILTER_StateSpace
+ * Method description:  Struct containing the matrices and state of a state-space block
+ * Params:              piCoefficients:         FILTER_STATE_SPACE_COEFFICIENTS(uiStates), Q31 scaled down by 2^ucPostShift
+ *                      iState:                 State vector x[n]
+ *                      uiStates:               Number of states, up to FILTER_MAX_STATES
+ *                      ucPostShift:            Coefficient scaling, lets coefficients reach 2^ucPostShift
+ */
+typedef struct
+{
+    const int32_t *piCoefficients;
+    int32_t iState[FILTER_MAX_STATES];
+    uint32_t uiStates;
+    uint8_t ucPostShift;
+} t_FILTER_StateSpace;
+
+/**
+ * Type name:           t_FILTER_Type
+ * Method description:  Structure of a filter design
+ */
+typedef enum
+{
+    FILTER_TYPE_NONE = 0,
+    FILTER_TYPE_BIQUAD,
+    FILTER_TYPE_STATE_SPACE
+} t_FILTER_Type;
+
+/**
+ * Type name:           t_FILTER_Design
+ * Method description:  Designs of the coefficient table, selected by the host.
+ *                      Cutoffs are relative to the rate the filter runs at.
+ * Params:              FILTER_DESIGN_NONE:             Pass-through
+ *                      FILTER_DESIGN_LOWPASS_1ST:      1st order low-pass at fs/10, 1 state
+ *                      FILTER_DESIGN_LOWPASS_2ND:      2nd order Butterworth low-pass at fs/10, 1 section
+ *                      FILTER_DESIGN_LOWPASS_2ND_SS:   Same response, 2 states
+ *                      FILTER_DESIGN_LOWPASS_4TH:      4th order Butterworth low-pass at fs/10, 2 sections
+ *                      FILTER_DESIGN_NOTCH:            Notch at fs/4, Q = 2, 1 section
+ */
+typedef enum
+{
+    FILTER_DESIGN_NONE = 0,
+    FILTER_DESIGN_LOWPASS_1ST,
+    FILTER_DESIGN_LOWPASS_2ND,
+    FILTER_DESIGN_LOWPASS_2ND_SS,
+    FILTER_DESIGN_LOWPASS_4TH,
+    FILTER_DESIGN_NOTCH,
+    FILTER_DESIGN_COUNT
+} t_FILTER_Design;
+
+/**
+ * Type name:           t_FILTER_Config
+ * Method description:  Entry of the coefficient table
+ * Params:              tType:                  Structure of the design
+ *                      uiOrder:                Biquad sections or state-space states
+ *                      ucPostShift:            Coefficient scaling
+ *                      piCoefficients:         Coefficients in the layout of tType
+ */
+typedef struct
+{
+    t_FILTER_Type tType;
+    uint32_t uiOrder;
+    uint8_t ucPostShift;
+    const int32_t *piCoefficients;
+} t_FILTER_Config;
+
+/**
+ * Type name:           t_FILTER_Data
+ * Method description:  Struct containing a filter slot running a design of the coefficient table
+ * Params:              tType:                  Structure of the running design
+ *                      iDesign:                t_FILTER_Design running
+ *                      tBiquad:                Biquad cascade, used with FILTER_TYPE_BIQUAD
+ *                      tStateSpace:            State-space block, used with FILTER_TYPE_STATE_SPACE
+ */
+typedef struct
+{
+    t_FILTER_Type tType;
+    int iDesign;
+    t_FILTER_Biquad tBiquad;
+    t_FILTER_StateSpace tStateSpace;
+} t_FILTER_Data;
+
+/**
+ * Method name:         filter_initBiquad
+ * Method description:  Sets the coefficients of a biquad cascade and clears its state
+ * Input params:        filter = t_FILTER_Biquad struct
+ *                      piCoefficients = FILTER_BIQUAD_COEFFICIENTS per section, kept by reference
+ *                      uiSections = Number of sections, limited to FILTER_MAX_SECTIONS
+ *                      ucPostShift = Coefficient scaling
+ * Output params:       n/a
+ */
+void filter_initBiquad(t_FILTER_Biquad *filter, const int32_t *piCoefficients, uint32_t uiSections, uint8_t ucPostShift);
+
+/**
+ * Method name:         filter_resetBiquad
+ * Method description:  Clears the state of a biquad cascade
+ * Input params:        filter = t_FILTER_Biquad struct
+ * Output params:       n/a
+ */
+void filter_resetBiquad(t_FILTER_Biquad *filter);
+
+/**
+ * Method name:         filter_biquadQ31
+ * Method description:  Filters one sample. The output is not saturated, the
+ *                      coefficients must leave headroom for the signal gain.
+ * Input params:        filter = t_FILTER_Biquad struct
+ *                      iInput = Sample, Q31
+ * Output params:       int32_t = Filtered sample, Q31
+ */
+int32_t filter_biquadQ31(t_FILTER_Biquad *filter, int32_t iInput);
+
+/**
+ * Method name:         filter_initStateSpace
+ * Method description:  Sets the matrices of a state-space block and clears its state
+ * Input params:        filter = t_FILTER_StateSpace struct
+ *                      piCoefficients = FILTER_STATE_SPACE_COEFFICIENTS(uiStates), kept by reference
+ *                      uiStates = Number of states, limited to FILTER_MAX_STATES
+ *                      ucPostShift = Coefficient scaling
+ * Output params:       n/a
+ */
+void filter_initStateSpace(t_FILTER_StateSpace *filter, const int32_t *piCoefficients, uint32_t uiStates, uint8_t ucPostShift);
+
+/**
+ * Method name:         filter_resetStateSpace
+ * Method description:  Clears the state of a state-space block
+ * Input params:        filter = t_FILTER_StateSpace struct
+ * Output params:       n/a
+ */
+void filter_resetStateSpace(t_FILTER_StateSpace *filter);
+
+/**
+ * Method name:         filter_stateSpaceQ31
+ * Method description:  Filters one sample. Neither the output nor the states are saturated,
+ *                      the matrices must leave headroom for the signal gain.
+ * Input params:        filter = t_FILTER_StateSpace struct
+ *                      iInput = Sample, Q31
+ * Output params:       int32_t = Filtered sample, Q31
+ */
+int32_t filter_stateSpaceQ31(t_FILTER_StateSpace *filter, int32_t iInput);
+
+/**
+ * Method name:         filter_initFilter
+ * Method description:  Loads a design of the coefficient table into a filter slot and clears its state
+ * Input params:        filter = t_FILTER_Data struct
+ *                      iDesign = t_FILTER_Design, out of range values select FILTER_DESIGN_NONE
+ * Output params:       n/a
+ */
+void filter_initFilter(t_FILTER_Data *filter, int iDesign);
+
+/**
+ * Method name:         filter_getDesign
+ * Method description:  Returns the design running in a filter slot
+ * Input params:        filter = t_FILTER_Data struct
+ * Output params:       int = t_FILTER_Design
+ */
+int filter_getDesign(const t_FILTER_Data *filter);
+
+/**
+ * Method name:         filter_update
+ * Method description:  Filters one sample with the design running in the slot
+ * Input params:        filter = t_FILTER_Data struct
+ *                      iInput = Sample, Q31 or Q16.16
+ * Output params:       int32_t = Filtered sample, same format
+ */
+int32_t filter_update(t_FILTER_Data *filter, int32_t iInput);
+
+#endif /* SOURCES_FILTER_H_ */
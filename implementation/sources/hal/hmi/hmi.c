@@ -9,13 +9,14 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       25Jun2016
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
 
 
 /* System includes */
+#include <stdlib.h>
 #include "fsl_clock_manager.h"
 #include "fsl_port_hal.h"
 #include "fsl_smc_hal.h"
@@ -25,10 +26,72 @@
 #include "hal/target_definitions.h"
 #include "hmi.h"
 #include "hal/controller/controller.h"
+#include "hal/driver/driver.h"
+#include "hal/current/current.h"
+#include "hal/encoder/encoder.h"
+#include "hal/trajectory/trajectory.h"
+#include "hal/ramp/ramp.h"
+#include "hal/filter/filter.h"
+#include "hal/feedforward/feedforward.h"
+#include "hal/profiler/profiler.h"
+#include "hal/scheduler/scheduler.h"
+#include "hal/benchmark/benchmark.h"
+#include "hal/serial/serial.h"
+#include "hal/telemetry/telemetry.h"
+
+/* Maximum number of received bytes parsed per hmi_receive call, bounds its execution time */
+#define HMI_RX_MAX_BYTES_PER_CALL   16
+/* Numbers are clamped to this value while being parsed */
+#define HMI_RX_MAX_NUMBER           100000000
+
+/* Telemetry modes, selected by the host with the 't' command */
+/* "%f %f %f" text lines */
+#define HMI_TELEMETRY_ASCII         0
+/* COBS framed binary, see telemetry.h */
+#define HMI_TELEMETRY_BINARY        1
+
+/**
+ * Type name:           t_HMI_ParserState
+ * Method description:  States of the command parser. A command is a letter followed by
+ *                      an optional sign, an integer and a line terminator, e.g. "v40\n".
+ *                      Fractional digits are accepted and ignored, as SCANF("%c%d") did.
+ * Params:              HMI_PARSER_IDLE:        Waiting for a command letter
+ *                      HMI_PARSER_NUMBER:      Accumulating the integer part
+ *                      HMI_PARSER_FRACTION:    Skipping fractional digits
+ *                      HMI_PARSER_DISCARD:     Malformed line, skipping up to its terminator
+ */
+typedef enum
+{
+    HMI_PARSER_IDLE,
+    HMI_PARSER_NUMBER,
+    HMI_PARSER_FRACTION,
+    HMI_PARSER_DISCARD
+} t_HMI_ParserState;
+
+/* Command parser state, kept across hmi_receive calls */
+static t_HMI_ParserState tHmiParserState = HMI_PARSER_IDLE;
+static char cHmiParserCommand;
+static int iHmiParserNumber;
+static int iHmiParserNegative;
+static int iHmiParserDigits;
+
+/* Current telemetry mode */
+static int iHmiTelemetryMode = HMI_TELEMETRY_ASCII;
 
 
 extern double dReferenceVelocity, dReferenceDirection;
+extern volatile int iPositionMode;
+extern t_TRAJECTORY_Profile tTrajectory;
+extern t_RAMP_Data tRamp;
+extern t_FILTER_Data tVelocityFilter, tDerivativeFilter, tActuatorFilter;
+extern volatile int iVelocitySource;
+extern t_FEEDFORWARD_Data tFeedforward;
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+extern int32_t iReferenceVelocityQ16;
+extern t_PID_Q16 pidDataQ16;
+#else
 extern t_PID_Data pidData;
+#endif
 
 /**
  * Method name:         hmi_initHmi
@@ -50,52 +113,387 @@ void hmi_initHmi()
 
     /* Initialize the debug console */
     DbgConsole_Init(HMI_UART_INSTANCE, HMI_UART_BAUD, kDebugConsoleLPSCI);
+
+    /* Non-blocking communication on top of the configured UART */
+    serial_initSerial();
 }
 
 /**
- * Method name:         hmi_receive
- * Method description:  Receives and interprets data sent from the host device.
+ * Method name:         hmi_setFilter
+ * Method description:  Loads a design into a filter slot of the control path and
+ *                      reports the designs of the three slots to the host device
+ * Input params:        filter: Filter slot
+ *                      iDesign: t_FILTER_Design
+ * Output params:       n/a
+ */
+static void hmi_setFilter(t_FILTER_Data *filter, int iDesign)
+{
+    /* The control task may run the filter in the tick ISR */
+    __disable_irq();
+    filter_initFilter(filter, iDesign);
+    __enable_irq();
+    serial_flush();
+    serial_printf("# filter %d %d %d\r\n", filter_getDesign(&tVelocityFilter), filter_getDesign(&tDerivativeFilter),
+            filter_getDesign(&tActuatorFilter));
+}
+
+/**
+ * Method name:         hmi_reportFeedforward
+ * Method description:  Reports the feedforward parameters in use to the host device, in the units of
+ *                      the 'u', 's', 'z' and 'y' commands
  * Input params:        n/a
  * Output params:       n/a
  */
-void hmi_receive()
+static void hmi_reportFeedforward(void)
 {
-    /* Check if there are characters on buffer */
-    if(0 == UART0_BRD_S1_RDRF(HMI_UART_BASE)) return;
-    char uiReceiveCommand;
-    int iReceiveNumber;
-    SCANF("%c%d", &uiReceiveCommand, &iReceiveNumber);
-    //PRINTF("Received: %c%d\r\n", uiReceiveCommand, iReceiveNumber);
-    switch(uiReceiveCommand)
+    const t_FEEDFORWARD_Parameters *parameters = feedforward_getParameters(&tFeedforward);
+
+    serial_flush();
+    serial_printf("# feedforward %d %d %d %d\r\n", (int)parameters->iStaticFriction, (int)parameters->iViscous,
+            (int)parameters->iInertia, (int)parameters->iBackEmf);
+}
+
+/**
+ * Method name:         hmi_applyCommand
+ * Method description:  Interprets a complete command received from the host device.
+ * Input params:        cCommand: Command letter
+ *                      iReceiveNumber: Command argument
+ * Output params:       n/a
+ */
+static void hmi_applyCommand(char cCommand, int iReceiveNumber)
+{
+    uint32_t uiIdle;
+
+    switch(cCommand)
     {
         case 'P':
         case 'p':
             iReceiveNumber = abs(iReceiveNumber);
+            /* The controller may be running in the tick ISR */
+            __disable_irq();
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+            controller_setKpQ16(&pidDataQ16, ((double)iReceiveNumber/10000));
+#else
             controller_setKp(&pidData, ((double)iReceiveNumber/10000));
+#endif
+            __enable_irq();
             break;
         case 'I':
         case 'i':
             iReceiveNumber = abs(iReceiveNumber);
+            /* The controller may be running in the tick ISR */
+            __disable_irq();
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+            controller_setKiQ16(&pidDataQ16, ((double)iReceiveNumber/10000));
+#else
             controller_setKi(&pidData, ((double)iReceiveNumber/10000));
+#endif
+            __enable_irq();
             break;
         case 'D':
         case 'd':
             iReceiveNumber = abs(iReceiveNumber);
+            /* The controller may be running in the tick ISR */
+            __disable_irq();
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+            controller_setKdQ16(&pidDataQ16, ((double)iReceiveNumber/10000));
+#else
             controller_setKd(&pidData, ((double)iReceiveNumber/10000));
+#endif
+            __enable_irq();
             break;
         case 'V':
         case 'v':
             iReceiveNumber = abs(iReceiveNumber);
+            __disable_irq();
             dReferenceVelocity = iReceiveNumber;
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+            iReferenceVelocityQ16 = CONTROLLER_INT_TO_Q16(iReceiveNumber);
+            controller_setMinReferenceQ16(&pidDataQ16, VELOCITY_MIN_REFERENCE_RAD);
+#else
+            controller_setMinReference(&pidData, VELOCITY_MIN_REFERENCE_RAD);
+#endif
+            /* Back to velocity mode */
+            iPositionMode = 0;
+            __enable_irq();
+            break;
+        case 'G':
+        case 'g':
+            /* Position mode, target in degrees from the position at power up */
+            __disable_irq();
+            if(!iPositionMode)
+            {
+                /* The profile starts from the measured state, the controller runs down to standstill and reverse */
+                trajectory_start(&tTrajectory, encoder_getMultiTurnCount(), encoder_getAngularVelocityRadQ16());
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+                controller_setMinReferenceQ16(&pidDataQ16, -(MAX_MOTOR_VELOCITY_RAD));
+#else
+                controller_setMinReference(&pidData, -(MAX_MOTOR_VELOCITY_RAD));
+#endif
+                iPositionMode = 1;
+            }
+            trajectory_setTargetDegrees(&tTrajectory, iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'M':
+        case 'm':
+            /* Position mode velocity limit, degrees/s */
+            __disable_irq();
+            trajectory_setMaxVelocityDegrees(&tTrajectory, iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'N':
+        case 'n':
+            /* Position mode acceleration limit, degrees/s^2 */
+            __disable_irq();
+            trajectory_setMaxAccelerationDegrees(&tTrajectory, iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'R':
+        case 'r':
+            /* r0 reports the stage timings, r1 also clears them */
+            profiler_report();
+            serial_flush();
+            serial_printf("# serial_dropped %u %u %u\r\n", serial_getTxDroppedMessages(), serial_getTxDroppedBytes(), serial_getRxDroppedBytes());
+            /* One cycle per scheduler tick */
+            uiIdle = profiler_getIdlePermille(SCHEDULER_TICK_PERIOD);
+            serial_printf("# idle %u.%u\r\n", uiIdle/10, uiIdle%10);
+            scheduler_report();
+            serial_flush();
+            serial_printf("# current %d %u\r\n", current_getCurrentMilliamps(), current_getDmaErrors());
+            if(iReceiveNumber)
+                profiler_resetStatistics();
+            break;
+        case 'T':
+        case 't':
+            /* t0 selects text telemetry, t1 binary frames */
+            iHmiTelemetryMode = iReceiveNumber ? HMI_TELEMETRY_BINARY : HMI_TELEMETRY_ASCII;
+            break;
+        case 'O':
+        case 'o':
+            /* o0 reports the deadline statistics, o1 also clears them, o2 disables and o3 enables telemetry shedding */
+            if(iReceiveNumber >= 2)
+                scheduler_setShedding(iReceiveNumber - 2);
+            scheduler_reportDeadlines();
+            scheduler_report();
+            if(1 == iReceiveNumber)
+                scheduler_resetStatistics();
+            break;
+        case 'B':
+        case 'b':
+            /* b<n> runs benchmark n, see t_BENCHMARK_Id */
+            benchmark_run(iReceiveNumber);
+            break;
+        case 'W':
+        case 'w':
+            /* PWM switching frequency in Hz */
+            driver_configurePwm(driver_getPwmMode(), abs(iReceiveNumber));
+            serial_flush();
+            serial_printf("# pwm %u %u %u\r\n", driver_getPwmMode(), driver_getFrequency(), driver_getResolution());
+            break;
+        case 'C':
+        case 'c':
+            /* c0 selects edge-aligned, c1 center-aligned PWM */
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+            /* The ADC is triggered by the TPM0 overflow, only mid-pulse in center-aligned mode. */
+            /* In edge-aligned mode it would sample the current at the switching edge */
+            if(!iReceiveNumber)
+            {
+                serial_flush();
+                serial_printf("# pwm edge-aligned rejected, the current loop needs center-aligned\r\n");
+                iReceiveNumber = 1;
+            }
+#endif
+            driver_configurePwm(iReceiveNumber ? DRIVER_PWM_CENTER_ALIGNED : DRIVER_PWM_EDGE_ALIGNED, driver_getFrequency());
+            serial_flush();
+            serial_printf("# pwm %u %u %u\r\n", driver_getPwmMode(), driver_getFrequency(), driver_getResolution());
+            break;
+        case 'A':
+        case 'a':
+            /* Velocity reference slew rate, rad/s^2, a0 applies steps */
+            __disable_irq();
+            ramp_setAcceleration(&tRamp, iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'J':
+        case 'j':
+            /* Velocity reference and position profile jerk, rad/s^3, j0 leaves the slew rate limit and trapezoid only */
+            __disable_irq();
+            ramp_setJerk(&tRamp, iReceiveNumber);
+            trajectory_setMaxJerkRad(&tTrajectory, iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'L':
+        case 'l':
+            /* Current limit in mA, bounds the velocity loop output and the current loop reference */
+            iReceiveNumber = abs(iReceiveNumber);
+            __disable_irq();
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+            controller_setOutputLimitsQ16(&pidDataQ16, -iReceiveNumber/1000.0, iReceiveNumber/1000.0);
+#else
+            controller_setOutputLimits(&pidData, -iReceiveNumber/1000.0, iReceiveNumber/1000.0);
+#endif
+#endif
+            current_setLimitMilliamps(iReceiveNumber);
+            __enable_irq();
+            break;
+        case 'F':
+        case 'f':
+            /* Measured velocity filter, f<n> loads design n, see t_FILTER_Design */
+            hmi_setFilter(&tVelocityFilter, iReceiveNumber);
+            break;
+        case 'H':
+        case 'h':
+            /* Derivative term filter, h<n> loads design n */
+            hmi_setFilter(&tDerivativeFilter, iReceiveNumber);
+            break;
+        case 'X':
+        case 'x':
+            /* Actuator command filter, x<n> loads design n */
+            hmi_setFilter(&tActuatorFilter, iReceiveNumber);
+            break;
+        case 'Q':
+        case 'q':
+            /* Velocity fed to the controller: q0 encoder window count, q1 observer */
+            iVelocitySource = iReceiveNumber ? VELOCITY_SOURCE_OBSERVER : VELOCITY_SOURCE_ENCODER;
+            break;
+        case 'K':
+        case 'k':
+            /* Feedforward parameters, k<n> loads set n of the table, k0 turns the feedforward off */
+            __disable_irq();
+            feedforward_initFeedforward(&tFeedforward, iReceiveNumber);
+            __enable_irq();
+            hmi_reportFeedforward();
+            break;
+        case 'U':
+        case 'u':
+            /* Static friction current, uA */
+            __disable_irq();
+            feedforward_setStaticFriction(&tFeedforward, iReceiveNumber);
+            __enable_irq();
+            hmi_reportFeedforward();
+            break;
+        case 'S':
+        case 's':
+            /* Viscous friction current, uA per rad/s */
+            __disable_irq();
+            feedforward_setViscous(&tFeedforward, iReceiveNumber);
+            __enable_irq();
+            hmi_reportFeedforward();
+            break;
+        case 'Z':
+        case 'z':
+            /* Inertia current, uA per rad/s^2 */
+            __disable_irq();
+            feedforward_setInertia(&tFeedforward, iReceiveNumber);
+            __enable_irq();
+            hmi_reportFeedforward();
+            break;
+        case 'Y':
+        case 'y':
+            /* Back-EMF constant, uV per rad/s */
+            __disable_irq();
+            feedforward_setBackEmf(&tFeedforward, iReceiveNumber);
+            __enable_irq();
+            hmi_reportFeedforward();
+            break;
+        case 'E':
+        case 'e':
+            /* Telemetry period in milliseconds, e0 stops the telemetry */
+            scheduler_setTaskPeriod(SCHEDULER_TASK_TELEMETRY, abs(iReceiveNumber));
             break;
         default:
             break;
     }
 }
 
+/**
+ * Method name:         hmi_parseByte
+ * Method description:  Feeds one received byte to the command parser, applying the
+ *                      command once its line terminator arrives.
+ * Input params:        cByte: Received byte
+ * Output params:       n/a
+ */
+static void hmi_parseByte(char cByte)
+{
+    int iEndOfLine = ('\r' == cByte) || ('\n' == cByte);
+
+    switch(tHmiParserState)
+    {
+        case HMI_PARSER_IDLE:
+            if((' ' == cByte) || iEndOfLine)
+                break;
+            cHmiParserCommand = cByte;
+            iHmiParserNumber = 0;
+            iHmiParserNegative = 0;
+            iHmiParserDigits = 0;
+            tHmiParserState = HMI_PARSER_NUMBER;
+            break;
+        case HMI_PARSER_NUMBER:
+            if((cByte >= '0') && (cByte <= '9'))
+            {
+                if(iHmiParserNumber < HMI_RX_MAX_NUMBER)
+                    iHmiParserNumber = 10*iHmiParserNumber + (cByte - '0');
+                iHmiParserDigits++;
+            }
+            else if(('-' == cByte) && (0 == iHmiParserDigits) && !iHmiParserNegative)
+                iHmiParserNegative = 1;
+            else if((' ' == cByte) && (0 == iHmiParserDigits))
+                break;
+            else if(('.' == cByte) && iHmiParserDigits)
+                tHmiParserState = HMI_PARSER_FRACTION;
+            else if(iEndOfLine)
+            {
+                if(iHmiParserDigits)
+                    hmi_applyCommand(cHmiParserCommand, iHmiParserNegative ? -iHmiParserNumber : iHmiParserNumber);
+                tHmiParserState = HMI_PARSER_IDLE;
+            }
+            else
+                tHmiParserState = HMI_PARSER_DISCARD;
+            break;
+        case HMI_PARSER_FRACTION:
+            if(iEndOfLine)
+            {
+                hmi_applyCommand(cHmiParserCommand, iHmiParserNegative ? -iHmiParserNumber : iHmiParserNumber);
+                tHmiParserState = HMI_PARSER_IDLE;
+            }
+            else if((cByte < '0') || (cByte > '9'))
+                tHmiParserState = HMI_PARSER_DISCARD;
+            break;
+        case HMI_PARSER_DISCARD:
+        default:
+            if(iEndOfLine)
+                tHmiParserState = HMI_PARSER_IDLE;
+            break;
+    }
+}
+
+/**
+ * Method name:         hmi_receive
+ * Method description:  Receives and interprets data sent from the host device.
+ *                      Never blocks: parses at most HMI_RX_MAX_BYTES_PER_CALL queued bytes,
+ *                      a partial line is kept until the rest arrives.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void hmi_receive()
+{
+    char cByte;
+    int iBytes;
+
+    for(iBytes = 0; iBytes < HMI_RX_MAX_BYTES_PER_CALL; iBytes++)
+    {
+        if(!serial_readByte(&cByte))
+            break;
+        hmi_parseByte(cByte);
+    }
+}
+
 /**
  * Method name:         hmi_transmit
- * Method description:  Transmits required data to the host device. Uses space as separator
+ * Method description:  Queues required data for transmission to the host device, without blocking.
+ *                      Text mode uses space as separator, binary mode sends one telemetry frame.
  * Input params:        dVelocity: Velocity reading from encoder
  *                      dPosition: Position reading from encoder
  *                      dActuator: Actuator value from controller
@@ -103,5 +501,19 @@ void hmi_receive()
  */
 void hmi_transmit(double dVelocity, double dPosition, double dActuator)
 {
-    PRINTF("%f %f %f\r\n", dVelocity, dPosition, dActuator);
+    uint8_t ucFrame[TELEMETRY_FRAME_MAX_SIZE];
+    uint32_t uiLength;
+
+    if(HMI_TELEMETRY_BINARY == iHmiTelemetryMode)
+    {
+        /* Hundredths, no float formatting. Called from the telemetry task, whose release count
+         * numbers the frames */
+        uiLength = telemetry_buildFrame(ucFrame, (uint8_t)scheduler_getTask(SCHEDULER_TASK_TELEMETRY)->uiReleases,
+                (int16_t)(dVelocity*100), (int32_t)(dPosition*100), (int16_t)(dActuator*100));
+        serial_write((const char *)ucFrame, uiLength);
+    }
+    else
+    {
+        serial_printf("%f %f %f\r\n", dVelocity, dPosition, dActuator);
+    }
 }
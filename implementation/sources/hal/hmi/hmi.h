@@ -9,7 +9,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       25Jun2016
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -27,6 +27,8 @@ void hmi_initHmi();
 /**
  * Method name:         hmi_receive
  * Method description:  Receives and interprets data sent from the host device.
+ *                      Never blocks: parses at most HMI_RX_MAX_BYTES_PER_CALL queued bytes,
+ *                      a partial line is kept until the rest arrives.
  * Input params:        n/a
  * Output params:       n/a
  */
@@ -34,7 +36,8 @@ void hmi_receive();
 
 /**
  * Method name:         hmi_transmit
- * Method description:  Transmits required data to the host device. Uses space as separator
+ * Method description:  Queues required data for transmission to the host device, without blocking.
+ *                      Text mode uses space as separator, binary mode sends one telemetry frame.
  * Input params:        dVelocity: Velocity reading from encoder
  *                      dPosition: Position reading from encoder
  *                      dActuator: Actuator value from controller
@@ -0,0 +1,111 @@
+/**
+ *
+ * File name:           observer.c
+ * File description:    File containing the methods for the velocity and
+ *                      acceleration observer.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "observer.h"
+#include "hal/target_definitions.h"
+#include "hal/encoder/encoder.h"
+#include "hal/controller/controller.h"
+
+/* Control periods per second, the observer advances once per period */
+#define OBSERVER_PERIODS_PER_SECOND     (1000000/(CYCLIC_EXECUTIVE_PERIOD))
+/* Critically damped tracker gains, Q16.16: alpha = 1 - theta^3, beta = 1.5*(1 - theta^2)*(1 - theta), */
+/* gamma = 0.5*(1 - theta)^3. The acceleration correction is 2*gamma per period squared */
+#define OBSERVER_ALPHA_Q16              CONTROLLER_Q16(1 - OBSERVER_THETA*OBSERVER_THETA*OBSERVER_THETA)
+#define OBSERVER_BETA_Q16               CONTROLLER_Q16(1.5*(1 - OBSERVER_THETA*OBSERVER_THETA)*(1 - OBSERVER_THETA))
+#define OBSERVER_2GAMMA_Q16             CONTROLLER_Q16((1 - OBSERVER_THETA)*(1 - OBSERVER_THETA)*(1 - OBSERVER_THETA))
+/* Counts per period to rad/s, and per period squared to rad/s^2, Q16.16 */
+#define OBSERVER_VELOCITY_TO_RAD_Q16    CONTROLLER_Q16(CONST_2PI*OBSERVER_PERIODS_PER_SECOND/ENCODER_QUADRATURE_COUNT)
+#define OBSERVER_ACCELERATION_TO_RAD_Q16 \
+        CONTROLLER_Q16(CONST_2PI*OBSERVER_PERIODS_PER_SECOND*OBSERVER_PERIODS_PER_SECOND/ENCODER_QUADRATURE_COUNT)
+/* Bound of the rate estimates, well above the motor, keeps them and their products within range */
+#define OBSERVER_MAX_RATE_Q16           (1L << 30)
+
+/**
+ * Method name:         observer_clamp
+ * Method description:  Limits a value to [-OBSERVER_MAX_RATE_Q16, OBSERVER_MAX_RATE_Q16]
+ * Input params:        llValue = Value
+ * Output params:       int32_t = Limited value
+ */
+static int32_t observer_clamp(int64_t llValue)
+{
+    if(llValue > OBSERVER_MAX_RATE_Q16)
+        return OBSERVER_MAX_RATE_Q16;
+    if(llValue < -OBSERVER_MAX_RATE_Q16)
+        return -OBSERVER_MAX_RATE_Q16;
+    return (int32_t)llValue;
+}
+
+/**
+ * Method name:         observer_initObserver
+ * Method description:  Starts the observer at rest at a position
+ * Input params:        observer = t_OBSERVER_Data struct
+ *                      llCount = Position in quadrature counts
+ * Output params:       n/a
+ */
+void observer_initObserver(t_OBSERVER_Data *observer, int64_t llCount)
+{
+    observer->llPosition = llCount*CONTROLLER_Q16_ONE;
+    observer->iVelocity = 0;
+    observer->iAcceleration = 0;
+}
+
+/**
+ * Method name:         observer_update
+ * Method description:  Advances the estimates by one control period and corrects them with a position sample
+ * Input params:        observer = t_OBSERVER_Data struct
+ *                      llCount = Measured position in quadrature counts
+ * Output params:       n/a
+ */
+void observer_update(t_OBSERVER_Data *observer, int64_t llCount)
+{
+    int64_t llResidual;
+
+    /* Prediction: constant acceleration over the period */
+    observer->llPosition += observer->iVelocity + (observer->iAcceleration >> 1);
+    observer->iVelocity = observer_clamp((int64_t)observer->iVelocity + observer->iAcceleration);
+
+    /* Correction by the position residual, a few counts while tracking */
+    llResidual = llCount*CONTROLLER_Q16_ONE - observer->llPosition;
+    if(llResidual > OBSERVER_MAX_RATE_Q16)
+        llResidual = OBSERVER_MAX_RATE_Q16;
+    else if(llResidual < -OBSERVER_MAX_RATE_Q16)
+        llResidual = -OBSERVER_MAX_RATE_Q16;
+    observer->llPosition += (llResidual*OBSERVER_ALPHA_Q16) >> CONTROLLER_Q16_SHIFT;
+    observer->iVelocity = observer_clamp(observer->iVelocity + ((llResidual*OBSERVER_BETA_Q16) >> CONTROLLER_Q16_SHIFT));
+    observer->iAcceleration = observer_clamp(observer->iAcceleration + ((llResidual*OBSERVER_2GAMMA_Q16) >> CONTROLLER_Q16_SHIFT));
+}
+
+/**
+ * Method name:         observer_getVelocityRadQ16
+ * Method description:  Returns the velocity estimate
+ * Input params:        observer = t_OBSERVER_Data struct
+ * Output params:       int32_t = Velocity in rad/s, Q16.16
+ */
+int32_t observer_getVelocityRadQ16(const t_OBSERVER_Data *observer)
+{
+    return (int32_t)(((int64_t)observer->iVelocity*OBSERVER_VELOCITY_TO_RAD_Q16) >> CONTROLLER_Q16_SHIFT);
+}
+
+/**
+ * Method name:         observer_getAccelerationRadQ16
+ * Method description:  Returns the acceleration estimate
+ * Input params:        observer = t_OBSERVER_Data struct
+ * Output params:       int32_t = Acceleration in rad/s^2, Q16.16
+ */
+int32_t observer_getAccelerationRadQ16(const t_OBSERVER_Data *observer)
+{
+    return (int32_t)(((int64_t)observer->iAcceleration*OBSERVER_ACCELERATION_TO_RAD_Q16) >> CONTROLLER_Q16_SHIFT);
+}
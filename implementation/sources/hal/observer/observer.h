@@ -0,0 +1,83 @@
+/**
+ *
+ * File name:           observer.h
+ * File description:    File containing the definition of methods for the
+ *                      velocity and acceleration observer.
+ *
+ *                      - Alpha-beta-gamma tracker on the multi-turn encoder
+ *                        position, run once per control period. It predicts
+ *                        position, velocity and acceleration and corrects
+ *                        them with the position residual, so the velocity
+ *                        estimate has no lag on ramps, unlike a count over
+ *                        the last window.
+ *                      - Gains of the critically damped (fading memory)
+ *                        tracker, fixed by OBSERVER_THETA and folded by the
+ *                        compiler, with the conversions for the configured
+ *                        period.
+ *                      - Integer Q16.16 in counts per period (position in
+ *                        64 bits), one call costs a few 64-bit multiplies.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_OBSERVER_H_
+#define SOURCES_OBSERVER_H_
+
+/* System includes */
+#include <stdint.h>
+
+/**
+ * Type name:           t_OBSERVER_Data
+ * Method description:  Struct containing the estimates of the observer
+ * Params:              llPosition:             Position, counts in Q16.16
+ *                      iVelocity:              Velocity, counts per period in Q16.16
+ *                      iAcceleration:          Acceleration, counts per period squared in Q16.16
+ */
+typedef struct
+{
+    int64_t llPosition;
+    int32_t iVelocity;
+    int32_t iAcceleration;
+} t_OBSERVER_Data;
+
+/**
+ * Method name:         observer_initObserver
+ * Method description:  Starts the observer at rest at a position
+ * Input params:        observer = t_OBSERVER_Data struct
+ *                      llCount = Position in quadrature counts
+ * Output params:       n/a
+ */
+void observer_initObserver(t_OBSERVER_Data *observer, int64_t llCount);
+
+/**
+ * Method name:         observer_update
+ * Method description:  Advances the estimates by one control period and corrects them with a position sample
+ * Input params:        observer = t_OBSERVER_Data struct
+ *                      llCount = Measured position in quadrature counts
+ * Output params:       n/a
+ */
+void observer_update(t_OBSERVER_Data *observer, int64_t llCount);
+
+/**
+ * Method name:         observer_getVelocityRadQ16
+ * Method description:  Returns the velocity estimate
+ * Input params:        observer = t_OBSERVER_Data struct
+ * Output params:       int32_t = Velocity in rad/s, Q16.16
+ */
+int32_t observer_getVelocityRadQ16(const t_OBSERVER_Data *observer);
+
+/**
+ * Method name:         observer_getAccelerationRadQ16
+ * Method description:  Returns the acceleration estimate
+ * Input params:        observer = t_OBSERVER_Data struct
+ * Output params:       int32_t = Acceleration in rad/s^2, Q16.16
+ */
+int32_t observer_getAccelerationRadQ16(const t_OBSERVER_Data *observer);
+
+#endif /* SOURCES_OBSERVER_H_ */
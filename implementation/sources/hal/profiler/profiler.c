@@ -0,0 +1,216 @@
+/**
+ *
+ * File name:           profiler.c
+ * File description:    File containing the methods for cycle-accurate
+ *                      profiling of the main loop stages.
+ *
+ *                      - Timestamps are taken from the SysTick down counter,
+ *                        running free at the core clock (24 bits).
+ *                      - A stage must not last longer than one SysTick wrap
+ *                        (2^24 cycles, about 419ms @ 40MHz).
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "profiler.h"
+#include "hal/target_definitions.h"
+#include "hal/serial/serial.h"
+
+/* SysTick is a 24 bit counter */
+#define PROFILER_SYSTICK_MASK       SysTick_LOAD_RELOAD_Msk
+
+/* Stage names, in t_PROFILER_Stage order */
+static const char *cProfilerStageName[PROFILER_STAGE_COUNT] =
+{
+    "encoder",
+    "controller",
+    "driver",
+    "hmi_receive",
+    "hmi_transmit",
+    "tick",
+    "latency",
+    "jitter",
+    "current_loop",
+    "encoder_capture",
+    "cycle"
+};
+
+/* Statistics of each stage */
+static t_PROFILER_Data tProfilerData[PROFILER_STAGE_COUNT];
+
+/**
+ * Method name:         profiler_initProfiler
+ * Method description:  Starts the SysTick as a free running counter and clears the statistics
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_initProfiler()
+{
+    /* Core clock source, no interrupt */
+    SysTick->CTRL = 0;
+    SysTick->LOAD = PROFILER_SYSTICK_MASK;
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    profiler_resetStatistics();
+}
+
+/**
+ * Method name:         profiler_resetStatistics
+ * Method description:  Clears the statistics of all stages
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_resetStatistics()
+{
+    int iStage, iBin;
+
+    for(iStage = 0; iStage < PROFILER_STAGE_COUNT; iStage++)
+    {
+        tProfilerData[iStage].uiMin = PROFILER_SYSTICK_MASK;
+        tProfilerData[iStage].uiMax = 0;
+        tProfilerData[iStage].ullSum = 0;
+        tProfilerData[iStage].uiCount = 0;
+        for(iBin = 0; iBin < PROFILER_HISTOGRAM_BINS; iBin++)
+            tProfilerData[iStage].uiHistogram[iBin] = 0;
+    }
+}
+
+/**
+ * Method name:         profiler_getTimestamp
+ * Method description:  Returns the current SysTick value
+ * Input params:        n/a
+ * Output params:       uint32_t = SysTick value (counts down)
+ */
+uint32_t profiler_getTimestamp()
+{
+    return SysTick->VAL;
+}
+
+/**
+ * Method name:         profiler_getElapsedCycles
+ * Method description:  Returns the cycles elapsed since a timestamp, handling the SysTick wrap
+ * Input params:        uiTimestamp = Value returned by profiler_getTimestamp
+ * Output params:       uint32_t = Elapsed core clock cycles
+ */
+uint32_t profiler_getElapsedCycles(uint32_t uiTimestamp)
+{
+    /* Down counter: elapsed = start - now, modulo 2^24 */
+    return (uiTimestamp - SysTick->VAL) & PROFILER_SYSTICK_MASK;
+}
+
+/**
+ * Method name:         profiler_startStage
+ * Method description:  Marks the beginning of a stage
+ * Input params:        tStage = Stage being measured
+ * Output params:       n/a
+ */
+void profiler_startStage(t_PROFILER_Stage tStage)
+{
+    tProfilerData[tStage].uiStart = SysTick->VAL;
+}
+
+/**
+ * Method name:         profiler_stopStage
+ * Method description:  Marks the end of a stage and updates its statistics
+ * Input params:        tStage = Stage being measured
+ * Output params:       n/a
+ */
+void profiler_stopStage(t_PROFILER_Stage tStage)
+{
+    profiler_addSample(tStage, profiler_getElapsedCycles(tProfilerData[tStage].uiStart));
+}
+
+/**
+ * Method name:         profiler_addSample
+ * Method description:  Adds a duration measured elsewhere to the statistics of a stage
+ * Input params:        tStage = Stage
+ *                      uiCycles = Duration, in core clock cycles
+ * Output params:       n/a
+ */
+void profiler_addSample(t_PROFILER_Stage tStage, uint32_t uiCycles)
+{
+    t_PROFILER_Data *tData = &tProfilerData[tStage];
+    uint32_t uiValue = uiCycles;
+    int iBin = 0;
+
+    if(uiCycles < tData->uiMin)
+        tData->uiMin = uiCycles;
+    if(uiCycles > tData->uiMax)
+        tData->uiMax = uiCycles;
+    tData->ullSum += uiCycles;
+    tData->uiCount++;
+
+    /* floor(log2(uiCycles)), the M0+ has no CLZ instruction */
+    while(uiValue >>= 1)
+        iBin++;
+    tData->uiHistogram[iBin]++;
+}
+
+/**
+ * Method name:         profiler_getStageData
+ * Method description:  Returns the statistics of a stage
+ * Input params:        tStage = Stage
+ * Output params:       const t_PROFILER_Data* = Statistics of the stage
+ */
+const t_PROFILER_Data *profiler_getStageData(t_PROFILER_Stage tStage)
+{
+    return &tProfilerData[tStage];
+}
+
+/**
+ * Method name:         profiler_getIdlePermille
+ * Method description:  Returns the share of the cyclic executive periods not spent in the cycle stage or the
+ *                      tick, current loop and encoder capture ISRs. Measured from the busy time, since SysTick
+ *                      stops while the core sleeps. ISRs preempting the cycle stage count twice, so it errs busy.
+ * Input params:        uiPeriodUs = Cyclic executive period, in microseconds
+ * Output params:       uint32_t = Idle time, in tenths of a percent
+ */
+uint32_t profiler_getIdlePermille(uint32_t uiPeriodUs)
+{
+    t_PROFILER_Data *tData = &tProfilerData[PROFILER_STAGE_CYCLE];
+    uint64_t ullPeriods = (uint64_t)tData->uiCount*uiPeriodUs*CORE_CLOCK_MHZ;
+    /* Work done in the ISRs is not part of the cycle stage. The current loop runs several times per tick */
+    uint64_t ullBusy = tData->ullSum + tProfilerData[PROFILER_STAGE_TICK].ullSum +
+            tProfilerData[PROFILER_STAGE_CURRENT_LOOP].ullSum + tProfilerData[PROFILER_STAGE_ENCODER_CAPTURE].ullSum;
+
+    if(!ullPeriods)
+        return 1000;
+    if(ullBusy >= ullPeriods)
+        return 0;
+    return 1000 - (uint32_t)((ullBusy*1000)/ullPeriods);
+}
+
+/**
+ * Method name:         profiler_report
+ * Method description:  Sends the statistics of all stages to the host device.
+ *                      One line per stage: name, min, max, mean and count in cycles,
+ *                      followed by the log2 histogram bins.
+ *                      Blocks until each line fits the transmit buffer.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_report()
+{
+    int iStage, iBin;
+    uint32_t uiMean;
+
+    for(iStage = 0; iStage < PROFILER_STAGE_COUNT; iStage++)
+    {
+        t_PROFILER_Data *tData = &tProfilerData[iStage];
+        uiMean = tData->uiCount ? (uint32_t)(tData->ullSum/tData->uiCount) : 0;
+        serial_flush();
+        serial_printf("# %s %u %u %u %u :", cProfilerStageName[iStage],
+               tData->uiCount ? tData->uiMin : 0, tData->uiMax, uiMean, tData->uiCount);
+        for(iBin = 0; iBin < PROFILER_HISTOGRAM_BINS; iBin++)
+            serial_printf(" %u", tData->uiHistogram[iBin]);
+        serial_printf("\r\n");
+    }
+}
@@ -0,0 +1,153 @@
+/**
+ *
+ * File name:           profiler.h
+ * File description:    File containing the definition of methods for
+ *                      cycle-accurate profiling of the main loop stages.
+ *
+ *                      - Timestamps are taken from the SysTick down counter,
+ *                        running free at the core clock (24 bits).
+ *                      - A stage must not last longer than one SysTick wrap
+ *                        (2^24 cycles, about 419ms @ 40MHz).
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_PROFILER_H_
+#define SOURCES_PROFILER_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Number of histogram bins, bin n holds durations in [2^n, 2^(n+1)) cycles */
+#define PROFILER_HISTOGRAM_BINS     24
+
+/**
+ * Type name:           t_PROFILER_Stage
+ * Method description:  Main loop stages being profiled
+ */
+typedef enum
+{
+    PROFILER_STAGE_ENCODER = 0,
+    PROFILER_STAGE_CONTROLLER,
+    PROFILER_STAGE_DRIVER,
+    PROFILER_STAGE_HMI_RECEIVE,
+    PROFILER_STAGE_HMI_TRANSMIT,
+    PROFILER_STAGE_TICK,
+    PROFILER_STAGE_LATENCY,
+    PROFILER_STAGE_JITTER,
+    PROFILER_STAGE_CURRENT_LOOP,
+    PROFILER_STAGE_ENCODER_CAPTURE,
+    PROFILER_STAGE_CYCLE,
+    PROFILER_STAGE_COUNT
+} t_PROFILER_Stage;
+
+/**
+ * Type name:           t_PROFILER_Data
+ * Method description:  Struct containing the statistics of one stage
+ * Params:              uiStart:                SysTick value when the stage started
+ *                      uiMin:                  Shortest duration, in cycles
+ *                      uiMax:                  Longest duration, in cycles
+ *                      ullSum:                 Sum of all durations, in cycles
+ *                      uiCount:                Number of measurements
+ *                      uiHistogram:            Log2 histogram of the durations
+ */
+typedef struct
+{
+    uint32_t uiStart;
+    uint32_t uiMin;
+    uint32_t uiMax;
+    uint64_t ullSum;
+    uint32_t uiCount;
+    uint32_t uiHistogram[PROFILER_HISTOGRAM_BINS];
+} t_PROFILER_Data;
+
+/**
+ * Method name:         profiler_initProfiler
+ * Method description:  Starts the SysTick as a free running counter and clears the statistics
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_initProfiler();
+
+/**
+ * Method name:         profiler_resetStatistics
+ * Method description:  Clears the statistics of all stages
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_resetStatistics();
+
+/**
+ * Method name:         profiler_getTimestamp
+ * Method description:  Returns the current SysTick value
+ * Input params:        n/a
+ * Output params:       uint32_t = SysTick value (counts down)
+ */
+uint32_t profiler_getTimestamp();
+
+/**
+ * Method name:         profiler_getElapsedCycles
+ * Method description:  Returns the cycles elapsed since a timestamp, handling the SysTick wrap
+ * Input params:        uiTimestamp = Value returned by profiler_getTimestamp
+ * Output params:       uint32_t = Elapsed core clock cycles
+ */
+uint32_t profiler_getElapsedCycles(uint32_t uiTimestamp);
+
+/**
+ * Method name:         profiler_startStage
+ * Method description:  Marks the beginning of a stage
+ * Input params:        tStage = Stage being measured
+ * Output params:       n/a
+ */
+void profiler_startStage(t_PROFILER_Stage tStage);
+
+/**
+ * Method name:         profiler_stopStage
+ * Method description:  Marks the end of a stage and updates its statistics
+ * Input params:        tStage = Stage being measured
+ * Output params:       n/a
+ */
+void profiler_stopStage(t_PROFILER_Stage tStage);
+
+/**
+ * Method name:         profiler_addSample
+ * Method description:  Adds a duration measured elsewhere to the statistics of a stage
+ * Input params:        tStage = Stage
+ *                      uiCycles = Duration, in core clock cycles
+ * Output params:       n/a
+ */
+void profiler_addSample(t_PROFILER_Stage tStage, uint32_t uiCycles);
+
+/**
+ * Method name:         profiler_getStageData
+ * Method description:  Returns the statistics of a stage
+ * Input params:        tStage = Stage
+ * Output params:       const t_PROFILER_Data* = Statistics of the stage
+ */
+const t_PROFILER_Data *profiler_getStageData(t_PROFILER_Stage tStage);
+
+/**
+ * Method name:         profiler_getIdlePermille
+ * Method description:  Returns the share of the cyclic executive periods not spent in the cycle stage or the
+ *                      tick, current loop and encoder capture ISRs. Measured from the busy time, since SysTick
+ *                      stops while the core sleeps. ISRs preempting the cycle stage count twice, so it errs busy.
+ * Input params:        uiPeriodUs = Cyclic executive period, in microseconds
+ * Output params:       uint32_t = Idle time, in tenths of a percent
+ */
+uint32_t profiler_getIdlePermille(uint32_t uiPeriodUs);
+
+/**
+ * Method name:         profiler_report
+ * Method description:  Sends the statistics of all stages to the host device
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void profiler_report();
+
+#endif /* SOURCES_PROFILER_H_ */
@@ -0,0 +1,153 @@
+/**
+ *
+ * File name:           ramp.c
+ * File description:    File containing the methods for the velocity
+ *                      reference shaping between the host and the
+ *                      controller.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <stdlib.h>
+
+/* Project includes */
+#include "ramp.h"
+#include "hal/target_definitions.h"
+#include "hal/controller/controller.h"
+
+/* Bound of host limits, keeps the conversions within 64 bits */
+#define RAMP_MAX_LIMIT              1000000
+/* Bound of the per-period increments, keeps iRate*(iRate + iJerk) and 2*iJerk*error within 64 bits */
+#define RAMP_MAX_RATE_Q16           (1L << 24)
+
+/**
+ * Method name:         ramp_perPeriodQ16
+ * Method description:  Converts a limit per second to Q16.16 per control period
+ * Input params:        iLimit = Limit per second, or per second squared
+ *                      iOrder = 1 per second, 2 per second squared
+ * Output params:       int32_t = Limit per period, or per period squared, 0 only if iLimit is 0
+ */
+static int32_t ramp_perPeriodQ16(int32_t iLimit, int iOrder)
+{
+    int64_t llLimit = abs(iLimit);
+
+    if(llLimit > RAMP_MAX_LIMIT)
+        llLimit = RAMP_MAX_LIMIT;
+    llLimit <<= CONTROLLER_Q16_SHIFT;
+    while(iOrder--)
+        llLimit = (llLimit*(CYCLIC_EXECUTIVE_PERIOD))/1000000;
+
+    if(iLimit && !llLimit)
+        return 1;
+    if(llLimit > RAMP_MAX_RATE_Q16)
+        return RAMP_MAX_RATE_Q16;
+    return (int32_t)llLimit;
+}
+
+/**
+ * Method name:         ramp_initRamp
+ * Method description:  Loads the REFERENCE_* limits and resets the ramp to 0
+ * Input params:        ramp = t_RAMP_Data struct
+ * Output params:       n/a
+ */
+void ramp_initRamp(t_RAMP_Data *ramp)
+{
+    ramp_reset(ramp, 0);
+    ramp_setAcceleration(ramp, REFERENCE_MAX_ACCELERATION);
+    ramp_setJerk(ramp, REFERENCE_MAX_JERK);
+}
+
+/**
+ * Method name:         ramp_setAcceleration
+ * Method description:  Sets the slew rate limit
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iAcceleration = Limit in units/s^2 (rad/s^2), 0 passes steps through
+ * Output params:       n/a
+ */
+void ramp_setAcceleration(t_RAMP_Data *ramp, int32_t iAcceleration)
+{
+    ramp->iMaxRate = ramp_perPeriodQ16(iAcceleration, 1);
+}
+
+/**
+ * Method name:         ramp_setJerk
+ * Method description:  Sets the jerk limit
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iJerk = Limit in units/s^3 (rad/s^3), 0 gives a plain slew rate limit
+ * Output params:       n/a
+ */
+void ramp_setJerk(t_RAMP_Data *ramp, int32_t iJerk)
+{
+    ramp->iJerk = ramp_perPeriodQ16(iJerk, 2);
+}
+
+/**
+ * Method name:         ramp_reset
+ * Method description:  Moves the ramp to a value at rest, e.g. the reference set by another source
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iValueQ16 = Value, Q16.16
+ * Output params:       n/a
+ */
+void ramp_reset(t_RAMP_Data *ramp, int32_t iValueQ16)
+{
+    ramp->iValue = iValueQ16;
+    ramp->iRate = 0;
+}
+
+/**
+ * Method name:         ramp_update
+ * Method description:  Advances the ramp towards the target by one control period
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iTargetQ16 = Reference set by the host, Q16.16
+ * Output params:       int32_t = Shaped reference, Q16.16
+ */
+int32_t ramp_update(t_RAMP_Data *ramp, int32_t iTargetQ16)
+{
+    int64_t llError = (int64_t)iTargetQ16 - ramp->iValue;
+    int32_t iDirection = 1;
+    int32_t iRate;
+
+    /* Work on the error and rate towards the target, the rate is negative moving away */
+    if(llError < 0)
+    {
+        iDirection = -1;
+        llError = -llError;
+    }
+
+    if(!ramp->iMaxRate)
+        /* No shaping */
+        iRate = (int32_t)llError;
+    else if(!ramp->iJerk)
+        /* Slew rate limit only */
+        iRate = (llError > ramp->iMaxRate) ? ramp->iMaxRate : (int32_t)llError;
+    else
+    {
+        iRate = iDirection*ramp->iRate;
+        /* Bringing iRate to 0 by iJerk per period moves the value by iRate*(iRate + iJerk)/(2*iJerk) */
+        if((iRate > 0) && ((int64_t)iRate*(iRate + ramp->iJerk) >= 2*ramp->iJerk*llError))
+            iRate = (iRate > ramp->iJerk) ? (iRate - ramp->iJerk) : 0;
+        else if(iRate < ramp->iMaxRate)
+            iRate = (iRate < ramp->iMaxRate - ramp->iJerk) ? (iRate + ramp->iJerk) : ramp->iMaxRate;
+        /* Limit lowered while ramping */
+        else if(iRate > ramp->iMaxRate)
+            iRate = (iRate - ramp->iJerk > ramp->iMaxRate) ? (iRate - ramp->iJerk) : ramp->iMaxRate;
+    }
+
+    /* Last step lands on the target */
+    if(llError <= iRate)
+    {
+        ramp_reset(ramp, iTargetQ16);
+        return iTargetQ16;
+    }
+
+    ramp->iRate = iDirection*iRate;
+    ramp->iValue += ramp->iRate;
+    return ramp->iValue;
+}
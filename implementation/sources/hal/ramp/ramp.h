@@ -0,0 +1,89 @@
+/**
+ *
+ * File name:           ramp.h
+ * File description:    File containing the definition of methods for the
+ *                      velocity reference shaping between the host and the
+ *                      controller.
+ *
+ *                      - Reference steps become ramps limited in slope
+ *                        (acceleration) and in change of slope (jerk).
+ *                      - Limits are converted once into Q16.16 increments per
+ *                        control period; ramp_update costs a few adds and
+ *                        one 64-bit multiply, no floating point.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_RAMP_H_
+#define SOURCES_RAMP_H_
+
+/* System includes */
+#include <stdint.h>
+
+/**
+ * Type name:           t_RAMP_Data
+ * Method description:  Struct containing the limits and state of a reference ramp
+ * Params:              iValue:                 Shaped reference, Q16.16
+ *                      iRate:                  Change of iValue in the last period, Q16.16
+ *                      iMaxRate:               Slew rate limit per period, Q16.16, 0 disables the ramp
+ *                      iJerk:                  Change of iRate per period, Q16.16, 0 disables the jerk limit
+ */
+typedef struct
+{
+    int32_t iValue;
+    int32_t iRate;
+    int32_t iMaxRate;
+    int32_t iJerk;
+} t_RAMP_Data;
+
+/**
+ * Method name:         ramp_initRamp
+ * Method description:  Loads the REFERENCE_* limits and resets the ramp to 0
+ * Input params:        ramp = t_RAMP_Data struct
+ * Output params:       n/a
+ */
+void ramp_initRamp(t_RAMP_Data *ramp);
+
+/**
+ * Method name:         ramp_setAcceleration
+ * Method description:  Sets the slew rate limit
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iAcceleration = Limit in units/s^2 (rad/s^2), 0 passes steps through
+ * Output params:       n/a
+ */
+void ramp_setAcceleration(t_RAMP_Data *ramp, int32_t iAcceleration);
+
+/**
+ * Method name:         ramp_setJerk
+ * Method description:  Sets the jerk limit
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iJerk = Limit in units/s^3 (rad/s^3), 0 gives a plain slew rate limit
+ * Output params:       n/a
+ */
+void ramp_setJerk(t_RAMP_Data *ramp, int32_t iJerk);
+
+/**
+ * Method name:         ramp_reset
+ * Method description:  Moves the ramp to a value at rest, e.g. the reference set by another source
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iValueQ16 = Value, Q16.16
+ * Output params:       n/a
+ */
+void ramp_reset(t_RAMP_Data *ramp, int32_t iValueQ16);
+
+/**
+ * Method name:         ramp_update
+ * Method description:  Advances the ramp towards the target by one control period
+ * Input params:        ramp = t_RAMP_Data struct
+ *                      iTargetQ16 = Reference set by the host, Q16.16
+ * Output params:       int32_t = Shaped reference, Q16.16
+ */
+int32_t ramp_update(t_RAMP_Data *ramp, int32_t iTargetQ16);
+
+#endif /* SOURCES_RAMP_H_ */
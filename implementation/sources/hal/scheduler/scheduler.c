@@ -0,0 +1,293 @@
+/**
+ *
+ * File name:           scheduler.c
+ * File description:    File containing the methods for the table-driven,
+ *                      multi-rate task scheduler.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include "fsl_interrupt_manager.h"
+
+/* Project includes */
+#include "scheduler.h"
+#include "hal/target_definitions.h"
+#include "hal/serial/serial.h"
+#include "hal/profiler/profiler.h"
+
+/* Microseconds to ticks */
+#define SCHEDULER_US_TO_TICKS(us)   ((us)/(SCHEDULER_TICK_PERIOD))
+
+/* Task table, indexed by t_SCHEDULER_TaskId */
+static t_SCHEDULER_Task tSchedulerTasks[SCHEDULER_TASK_COUNT] =
+{
+    /* Encoder, PID and PWM */
+    [SCHEDULER_TASK_CONTROL] =
+    {
+            .pcName = "control",
+            .task = main_controlTask,
+            .uiPeriod = SCHEDULER_US_TO_TICKS(CYCLIC_EXECUTIVE_PERIOD),
+            .uiOffset = 0,
+            .uiPriority = 0,
+#if (CONTROL_MODE == CONTROL_MODE_ISR)
+            .tContext = SCHEDULER_CONTEXT_TICK,
+#else
+            .tContext = SCHEDULER_CONTEXT_MAIN,
+#endif
+    },
+    /* Host commands */
+    [SCHEDULER_TASK_HMI_RECEIVE] =
+    {
+            .pcName = "hmi_receive",
+            .task = main_hmiReceiveTask,
+            .uiPeriod = SCHEDULER_US_TO_TICKS(HMI_RECEIVE_TASK_PERIOD),
+            .uiOffset = 1,
+            .uiPriority = 1,
+            .tContext = SCHEDULER_CONTEXT_MAIN,
+    },
+    /* Telemetry, rate set by the host */
+    [SCHEDULER_TASK_TELEMETRY] =
+    {
+            .pcName = "telemetry",
+            .task = main_telemetryTask,
+            .uiPeriod = SCHEDULER_US_TO_TICKS(TELEMETRY_TASK_PERIOD),
+            .uiOffset = 0,
+            .uiPriority = 2,
+            .tContext = SCHEDULER_CONTEXT_MAIN,
+            .uiSheddable = 1,
+    },
+};
+
+/* Ticks since initialization */
+static volatile uint32_t uiSchedulerTicks = 0;
+/* Set while the main loop runs the pending tasks */
+static volatile uint32_t uiSchedulerBusy = 0;
+/* Ticks that arrived before the previous pass or tick ISR ended */
+static volatile uint32_t uiSchedulerDeadlineMisses = 0;
+/* Longest pass over the pending tasks, in cycles, interrupts included */
+static uint32_t uiSchedulerWorstPass = 0;
+/* Drop late sheddable tasks */
+static uint32_t uiSchedulerShedding = SCHEDULER_SHEDDING;
+
+/**
+ * Method name:         scheduler_initScheduler
+ * Method description:  Resets the tick count and schedules the first release of every task
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_initScheduler()
+{
+    int iTask;
+
+    uiSchedulerTicks = 0;
+    for(iTask = 0; iTask < SCHEDULER_TASK_COUNT; iTask++)
+    {
+        tSchedulerTasks[iTask].uiNextRelease = tSchedulerTasks[iTask].uiOffset;
+        tSchedulerTasks[iTask].uiPending = 0;
+        tSchedulerTasks[iTask].uiReleases = 0;
+    }
+    scheduler_resetStatistics();
+}
+
+/**
+ * Method name:         scheduler_tick
+ * Method description:  Advances the tick count and releases the tasks that are due, running
+ *                      the tick context ones at once. Called from the tick ISR
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_tick()
+{
+    int iTask;
+    uint32_t uiTicks = ++uiSchedulerTicks;
+    uint32_t uiStart = profiler_getTimestamp();
+
+    /* The main loop should have finished before this tick */
+    if(uiSchedulerBusy)
+        uiSchedulerDeadlineMisses++;
+
+    for(iTask = 0; iTask < SCHEDULER_TASK_COUNT; iTask++)
+    {
+        t_SCHEDULER_Task *tTask = &tSchedulerTasks[iTask];
+
+        /* Wrap-safe comparison, no division in the ISR */
+        if(!tTask->uiPeriod || ((int32_t)(uiTicks - tTask->uiNextRelease) < 0))
+            continue;
+        tTask->uiNextRelease += tTask->uiPeriod;
+        tTask->uiReleases++;
+
+        if(SCHEDULER_CONTEXT_TICK == tTask->tContext)
+        {
+            /* Table order keeps the latency from the tick fixed */
+            tTask->task();
+            tTask->uiRuns++;
+        }
+        else if(tTask->uiPending)
+            tTask->uiOverruns++;
+        else
+        {
+            tTask->uiReleaseTick = uiTicks;
+            tTask->uiPending = 1;
+        }
+    }
+
+    /* Tick tasks must end within the tick as well */
+    if(profiler_getElapsedCycles(uiStart) > SCHEDULER_TICK_PERIOD*CORE_CLOCK_MHZ)
+        uiSchedulerDeadlineMisses++;
+}
+
+/**
+ * Method name:         scheduler_runPending
+ * Method description:  Runs the released tasks, highest priority first, until none is pending
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_runPending()
+{
+    int iTask;
+    t_SCHEDULER_Task *tNext;
+    uint32_t uiStart = profiler_getTimestamp();
+    uint32_t uiCycles;
+
+    uiSchedulerBusy = 1;
+    for(;;)
+    {
+        tNext = 0;
+        for(iTask = 0; iTask < SCHEDULER_TASK_COUNT; iTask++)
+            if(tSchedulerTasks[iTask].uiPending && (!tNext || (tSchedulerTasks[iTask].uiPriority < tNext->uiPriority)))
+                tNext = &tSchedulerTasks[iTask];
+        if(!tNext)
+            break;
+
+        tNext->uiPending = 0;
+        /* Released before the current tick: this pass is already late */
+        if(uiSchedulerShedding && tNext->uiSheddable && (tNext->uiReleaseTick != uiSchedulerTicks))
+        {
+            tNext->uiDropped++;
+            continue;
+        }
+        tNext->task();
+        tNext->uiRuns++;
+    }
+    uiSchedulerBusy = 0;
+
+    uiCycles = profiler_getElapsedCycles(uiStart);
+    if(uiCycles > uiSchedulerWorstPass)
+        uiSchedulerWorstPass = uiCycles;
+}
+
+/**
+ * Method name:         scheduler_setTaskPeriod
+ * Method description:  Changes the period of a task, the next release is one new period from now
+ * Input params:        tTask = Task
+ *                      uiPeriodMs = Period in milliseconds, rounded down to ticks, 0 disables the task
+ * Output params:       n/a
+ */
+void scheduler_setTaskPeriod(t_SCHEDULER_TaskId tTask, uint32_t uiPeriodMs)
+{
+    uint32_t uiPeriod = SCHEDULER_US_TO_TICKS(1000*uiPeriodMs);
+
+    /* Shorter than one tick runs on every tick */
+    if(uiPeriodMs && !uiPeriod)
+        uiPeriod = 1;
+
+    __disable_irq();
+    tSchedulerTasks[tTask].uiPeriod = uiPeriod;
+    tSchedulerTasks[tTask].uiNextRelease = uiSchedulerTicks + uiPeriod;
+    __enable_irq();
+}
+
+/**
+ * Method name:         scheduler_getTicks
+ * Method description:  Returns the number of ticks since initialization
+ * Input params:        n/a
+ * Output params:       uint32_t = Ticks
+ */
+uint32_t scheduler_getTicks()
+{
+    return uiSchedulerTicks;
+}
+
+/**
+ * Method name:         scheduler_getTask
+ * Method description:  Returns the configuration and statistics of a task
+ * Input params:        tTask = Task
+ * Output params:       const t_SCHEDULER_Task* = Task entry
+ */
+const t_SCHEDULER_Task *scheduler_getTask(t_SCHEDULER_TaskId tTask)
+{
+    return &tSchedulerTasks[tTask];
+}
+
+/**
+ * Method name:         scheduler_setShedding
+ * Method description:  Enables or disables dropping late sheddable tasks
+ * Input params:        iEnable = 0 runs late tasks anyway, otherwise drops them
+ * Output params:       n/a
+ */
+void scheduler_setShedding(int iEnable)
+{
+    uiSchedulerShedding = (0 != iEnable);
+}
+
+/**
+ * Method name:         scheduler_resetStatistics
+ * Method description:  Clears the run, overrun, drop and deadline statistics
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_resetStatistics()
+{
+    int iTask;
+
+    __disable_irq();
+    for(iTask = 0; iTask < SCHEDULER_TASK_COUNT; iTask++)
+    {
+        tSchedulerTasks[iTask].uiRuns = 0;
+        tSchedulerTasks[iTask].uiOverruns = 0;
+        tSchedulerTasks[iTask].uiDropped = 0;
+    }
+    uiSchedulerDeadlineMisses = 0;
+    uiSchedulerWorstPass = 0;
+    __enable_irq();
+}
+
+/**
+ * Method name:         scheduler_reportDeadlines
+ * Method description:  Sends the deadline statistics to the host device: ticks, deadline
+ *                      misses, worst pass time in cycles and whether shedding is enabled
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_reportDeadlines()
+{
+    serial_flush();
+    serial_printf("# deadline %u %u %u %u\r\n", uiSchedulerTicks, uiSchedulerDeadlineMisses,
+            uiSchedulerWorstPass, uiSchedulerShedding);
+}
+
+/**
+ * Method name:         scheduler_report
+ * Method description:  Sends the statistics of all tasks to the host device.
+ *                      One line per task: name, period in ticks, runs, overruns and drops.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_report()
+{
+    int iTask;
+
+    for(iTask = 0; iTask < SCHEDULER_TASK_COUNT; iTask++)
+    {
+        serial_flush();
+        serial_printf("# task %s %u %u %u %u\r\n", tSchedulerTasks[iTask].pcName, tSchedulerTasks[iTask].uiPeriod,
+                tSchedulerTasks[iTask].uiRuns, tSchedulerTasks[iTask].uiOverruns, tSchedulerTasks[iTask].uiDropped);
+    }
+}
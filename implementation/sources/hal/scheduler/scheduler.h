@@ -0,0 +1,185 @@
+/**
+ *
+ * File name:           scheduler.h
+ * File description:    File containing the definition of methods for the
+ *                      table-driven, multi-rate task scheduler.
+ *
+ *                      - The LPTMR tick (SCHEDULER_TICK_PERIOD) releases
+ *                        the tasks of the static table in scheduler.c.
+ *                      - Released tasks run to completion in the main loop,
+ *                        highest priority first.
+ *                      - A task released again before it ran counts an
+ *                        overrun; the release is not queued twice.
+ *                      - Tasks in the tick context run inside the tick ISR
+ *                        at release, ahead of the main loop tasks.
+ *                      - Every pass over the pending tasks must end before
+ *                        the next tick, a later tick counts a deadline miss.
+ *                        Sheddable tasks released before the current tick
+ *                        can then be dropped instead of run late.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_SCHEDULER_H_
+#define SOURCES_SCHEDULER_H_
+
+/* System includes */
+#include <stdint.h>
+
+/**
+ * Type name:           t_SCHEDULER_TaskId
+ * Method description:  Tasks in the scheduler table, in table order
+ */
+typedef enum
+{
+    SCHEDULER_TASK_CONTROL = 0,
+    SCHEDULER_TASK_HMI_RECEIVE,
+    SCHEDULER_TASK_TELEMETRY,
+    SCHEDULER_TASK_COUNT
+} t_SCHEDULER_TaskId;
+
+/**
+ * Type name:           t_SCHEDULER_Context
+ * Method description:  Where a task runs once released
+ */
+typedef enum
+{
+    /* Main loop, in priority order, preempted by interrupts */
+    SCHEDULER_CONTEXT_MAIN = 0,
+    /* Tick ISR, at a fixed latency from the tick */
+    SCHEDULER_CONTEXT_TICK
+} t_SCHEDULER_Context;
+
+/**
+ * Type name:           t_SCHEDULER_Task
+ * Method description:  Struct containing the configuration and state of one task
+ * Params:              pcName:                 Name used in the report
+ *                      task:                   Function run on each release
+ *                      uiPeriod:               Release period in ticks, 0 disables the task
+ *                      uiOffset:               Tick of the first release
+ *                      uiPriority:             Lower value runs first
+ *                      tContext:               Main loop or tick ISR
+ *                      uiSheddable:            May be dropped when late
+ *                      uiNextRelease:          Tick of the next release
+ *                      uiPending:              Released and not run yet
+ *                      uiRuns:                 Number of completed runs
+ *                      uiOverruns:             Releases lost because the previous one had not run
+ *                      uiReleaseTick:          Tick of the pending release
+ *                      uiDropped:              Late releases dropped by load shedding
+ *                      uiReleases:             Releases since initialization, run or lost, kept by
+ *                                              scheduler_resetStatistics. Gaps in it mark lost periods
+ */
+typedef struct
+{
+    const char *pcName;
+    void (*task)(void);
+    uint32_t uiPeriod;
+    uint32_t uiOffset;
+    uint32_t uiPriority;
+    t_SCHEDULER_Context tContext;
+    uint32_t uiSheddable;
+    uint32_t uiNextRelease;
+    volatile uint32_t uiPending;
+    uint32_t uiRuns;
+    volatile uint32_t uiOverruns;
+    volatile uint32_t uiReleaseTick;
+    uint32_t uiDropped;
+    volatile uint32_t uiReleases;
+} t_SCHEDULER_Task;
+
+/* Tasks, implemented by the application */
+extern void main_controlTask(void);
+extern void main_hmiReceiveTask(void);
+extern void main_telemetryTask(void);
+
+/**
+ * Method name:         scheduler_initScheduler
+ * Method description:  Resets the tick count and schedules the first release of every task
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_initScheduler();
+
+/**
+ * Method name:         scheduler_tick
+ * Method description:  Advances the tick count and releases the tasks that are due, running
+ *                      the tick context ones at once. Called from the tick ISR
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_tick();
+
+/**
+ * Method name:         scheduler_runPending
+ * Method description:  Runs the released tasks, highest priority first, until none is pending
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_runPending();
+
+/**
+ * Method name:         scheduler_setTaskPeriod
+ * Method description:  Changes the period of a task, the next release is one new period from now
+ * Input params:        tTask = Task
+ *                      uiPeriodMs = Period in milliseconds, rounded down to ticks, 0 disables the task
+ * Output params:       n/a
+ */
+void scheduler_setTaskPeriod(t_SCHEDULER_TaskId tTask, uint32_t uiPeriodMs);
+
+/**
+ * Method name:         scheduler_getTicks
+ * Method description:  Returns the number of ticks since initialization
+ * Input params:        n/a
+ * Output params:       uint32_t = Ticks
+ */
+uint32_t scheduler_getTicks();
+
+/**
+ * Method name:         scheduler_getTask
+ * Method description:  Returns the configuration and statistics of a task
+ * Input params:        tTask = Task
+ * Output params:       const t_SCHEDULER_Task* = Task entry
+ */
+const t_SCHEDULER_Task *scheduler_getTask(t_SCHEDULER_TaskId tTask);
+
+/**
+ * Method name:         scheduler_setShedding
+ * Method description:  Enables or disables dropping late sheddable tasks
+ * Input params:        iEnable = 0 runs late tasks anyway, otherwise drops them
+ * Output params:       n/a
+ */
+void scheduler_setShedding(int iEnable);
+
+/**
+ * Method name:         scheduler_resetStatistics
+ * Method description:  Clears the run, overrun, drop and deadline statistics
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_resetStatistics();
+
+/**
+ * Method name:         scheduler_reportDeadlines
+ * Method description:  Sends the deadline statistics to the host device: ticks, deadline
+ *                      misses, worst pass time in cycles and whether shedding is enabled
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_reportDeadlines();
+
+/**
+ * Method name:         scheduler_report
+ * Method description:  Sends the statistics of all tasks to the host device.
+ *                      One line per task: name, period in ticks, runs, overruns and drops.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void scheduler_report();
+
+#endif /* SOURCES_SCHEDULER_H_ */
@@ -0,0 +1,230 @@
+/**
+ *
+ * File name:           serial.c
+ * File description:    File containing the methods for interrupt driven,
+ *                      non-blocking, communication over the HMI UART.
+ *
+ *                      - Data is copied to a ring buffer and drained by the
+ *                        UART0 transmit data register empty interrupt.
+ *                      - A message that does not fit the free space is
+ *                        dropped whole and counted, never split.
+ *                      - Received bytes are queued by the UART0 receive data
+ *                        register full interrupt and read one at a time.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* System includes */
+#include <stdarg.h>
+#include "fsl_interrupt_manager.h"
+
+/* Project includes */
+#include "serial.h"
+#include "hal/target_definitions.h"
+#include "hal/uart/print_scan.h"
+
+#define SERIAL_TX_BUFFER_MASK       (SERIAL_TX_BUFFER_SIZE - 1)
+#define SERIAL_RX_BUFFER_MASK       (SERIAL_RX_BUFFER_SIZE - 1)
+
+/* Transmit ring buffer. Head is only written by the producer, tail only by the IRQ */
+static char cSerialTxBuffer[SERIAL_TX_BUFFER_SIZE];
+static volatile uint32_t uiSerialTxHead = 0;
+static volatile uint32_t uiSerialTxTail = 0;
+
+/* Receive ring buffer. Head is only written by the IRQ, tail only by the consumer */
+static char cSerialRxBuffer[SERIAL_RX_BUFFER_SIZE];
+static volatile uint32_t uiSerialRxHead = 0;
+static volatile uint32_t uiSerialRxTail = 0;
+
+/* Overflow counters */
+static volatile uint32_t uiSerialTxDroppedMessages = 0;
+static volatile uint32_t uiSerialTxDroppedBytes = 0;
+static volatile uint32_t uiSerialRxDroppedBytes = 0;
+
+/**
+ * Method name:         UART0_IRQHandler
+ * Method description:  UART0 IRQ handler, fills the receive queue and drains the transmit ring buffer
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void UART0_IRQHandler()
+{
+    char cByte;
+
+    if(UART0_BRD_S1_OR(HMI_UART_BASE))
+    {
+        /* Receiver stops until the overrun flag is cleared (w1c) */
+        UART0_WR_S1(HMI_UART_BASE, UART0_S1_OR_MASK);
+        uiSerialRxDroppedBytes++;
+    }
+
+    if(UART0_BRD_S1_RDRF(HMI_UART_BASE))
+    {
+        /* Reading D clears RDRF */
+        cByte = UART0_RD_D(HMI_UART_BASE);
+        if((uiSerialRxHead - uiSerialRxTail) < SERIAL_RX_BUFFER_SIZE)
+        {
+            cSerialRxBuffer[uiSerialRxHead & SERIAL_RX_BUFFER_MASK] = cByte;
+            uiSerialRxHead++;
+        }
+        else
+        {
+            uiSerialRxDroppedBytes++;
+        }
+    }
+
+    if(UART0_BRD_C2_TIE(HMI_UART_BASE) && UART0_BRD_S1_TDRE(HMI_UART_BASE))
+    {
+        if(uiSerialTxTail != uiSerialTxHead)
+        {
+            UART0_WR_D(HMI_UART_BASE, cSerialTxBuffer[uiSerialTxTail & SERIAL_TX_BUFFER_MASK]);
+            uiSerialTxTail++;
+        }
+        else
+        {
+            /* Nothing left to send */
+            UART0_BWR_C2_TIE(HMI_UART_BASE, 0);
+        }
+    }
+}
+
+/**
+ * Method name:         serial_initSerial
+ * Method description:  Initializes the ring buffers and enables the UART interrupt.
+ *                      The UART must already be configured by hmi_initHmi.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void serial_initSerial()
+{
+    uiSerialTxHead = 0;
+    uiSerialTxTail = 0;
+    uiSerialRxHead = 0;
+    uiSerialRxTail = 0;
+    uiSerialTxDroppedMessages = 0;
+    uiSerialTxDroppedBytes = 0;
+    uiSerialRxDroppedBytes = 0;
+
+    /* Transmit interrupt is only enabled while there is data queued */
+    UART0_BWR_C2_TIE(HMI_UART_BASE, 0);
+    UART0_BWR_C2_RIE(HMI_UART_BASE, 1);
+    NVIC_EnableIRQ(UART0_IRQn);
+}
+
+/**
+ * Method name:         serial_write
+ * Method description:  Queues a message for transmission, returns immediately
+ * Input params:        pcData = Message
+ *                      uiLength = Message length in bytes
+ * Output params:       uint32_t = Bytes queued, 0 if the message was dropped
+ */
+uint32_t serial_write(const char *pcData, uint32_t uiLength)
+{
+    uint32_t uiHead = uiSerialTxHead;
+    uint32_t uiFree = SERIAL_TX_BUFFER_SIZE - (uiHead - uiSerialTxTail);
+    uint32_t uiIndex;
+
+    if(uiLength > uiFree)
+    {
+        uiSerialTxDroppedMessages++;
+        uiSerialTxDroppedBytes += uiLength;
+        return 0;
+    }
+
+    for(uiIndex = 0; uiIndex < uiLength; uiIndex++)
+        cSerialTxBuffer[(uiHead + uiIndex) & SERIAL_TX_BUFFER_MASK] = pcData[uiIndex];
+
+    /* Publish the data before (re)enabling the transmitter interrupt */
+    uiSerialTxHead = uiHead + uiLength;
+    UART0_BWR_C2_TIE(HMI_UART_BASE, 1);
+
+    return uiLength;
+}
+
+/**
+ * Method name:         serial_printf
+ * Method description:  Formats a message and queues it for transmission, returns immediately
+ * Input params:        pcFormat = printf-like format, followed by its arguments
+ * Output params:       uint32_t = Bytes queued, 0 if the message was dropped
+ */
+uint32_t serial_printf(const char *pcFormat, ...)
+{
+    char cMessage[SERIAL_PRINTF_BUFFER_SIZE];
+    char *pcEnd = cMessage;
+    va_list ap;
+
+    va_start(ap, pcFormat);
+    _doprint(&pcEnd, _sputc, SERIAL_PRINTF_BUFFER_SIZE, (char *)pcFormat, ap);
+    va_end(ap);
+
+    return serial_write(cMessage, pcEnd - cMessage);
+}
+
+/**
+ * Method name:         serial_flush
+ * Method description:  Blocks until the transmit ring buffer is empty
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void serial_flush()
+{
+    while(uiSerialTxTail != uiSerialTxHead);
+}
+
+/**
+ * Method name:         serial_readByte
+ * Method description:  Takes one received byte from the queue, returns immediately
+ * Input params:        pcByte = Where the byte is stored
+ * Output params:       int = 1 if a byte was read, 0 if the queue was empty
+ */
+int serial_readByte(char *pcByte)
+{
+    uint32_t uiTail = uiSerialRxTail;
+
+    if(uiTail == uiSerialRxHead)
+        return 0;
+
+    *pcByte = cSerialRxBuffer[uiTail & SERIAL_RX_BUFFER_MASK];
+    uiSerialRxTail = uiTail + 1;
+    return 1;
+}
+
+/**
+ * Method name:         serial_getTxDroppedMessages
+ * Method description:  Returns how many messages were dropped because the buffer was full
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped messages
+ */
+uint32_t serial_getTxDroppedMessages()
+{
+    return uiSerialTxDroppedMessages;
+}
+
+/**
+ * Method name:         serial_getTxDroppedBytes
+ * Method description:  Returns how many bytes were dropped because the buffer was full
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped bytes
+ */
+uint32_t serial_getTxDroppedBytes()
+{
+    return uiSerialTxDroppedBytes;
+}
+
+/**
+ * Method name:         serial_getRxDroppedBytes
+ * Method description:  Returns how many received bytes were lost, either because the
+ *                      queue was full or because of a UART overrun
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped bytes
+ */
+uint32_t serial_getRxDroppedBytes()
+{
+    return uiSerialRxDroppedBytes;
+}
@@ -0,0 +1,112 @@
+/**
+ *
+ * File name:           serial.h
+ * File description:    File containing the definition of methods for
+ *                      interrupt driven, non-blocking, communication over
+ *                      the HMI UART.
+ *
+ *                      - Data is copied to a ring buffer and drained by the
+ *                        UART0 transmit data register empty interrupt.
+ *                      - A message that does not fit the free space is
+ *                        dropped whole and counted, never split.
+ *                      - Received bytes are queued by the UART0 receive data
+ *                        register full interrupt and read one at a time.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_SERIAL_H_
+#define SOURCES_SERIAL_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Transmit ring buffer size, must be a power of 2 */
+#define SERIAL_TX_BUFFER_SIZE       512
+/* Receive ring buffer size, must be a power of 2 */
+#define SERIAL_RX_BUFFER_SIZE       64
+/* Largest message serial_printf can format */
+#define SERIAL_PRINTF_BUFFER_SIZE   128
+
+/**
+ * Method name:         serial_initSerial
+ * Method description:  Initializes the ring buffers and enables the UART interrupt.
+ *                      The UART must already be configured by hmi_initHmi.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void serial_initSerial();
+
+/**
+ * Method name:         serial_write
+ * Method description:  Queues a message for transmission, returns immediately
+ * Input params:        pcData = Message
+ *                      uiLength = Message length in bytes
+ * Output params:       uint32_t = Bytes queued, 0 if the message was dropped
+ */
+uint32_t serial_write(const char *pcData, uint32_t uiLength);
+
+/**
+ * Method name:         serial_printf
+ * Method description:  Formats a message and queues it for transmission, returns immediately
+ * Input params:        pcFormat = printf-like format, followed by its arguments
+ * Output params:       uint32_t = Bytes queued, 0 if the message was dropped
+ */
+uint32_t serial_printf(const char *pcFormat, ...);
+
+/**
+ * Method name:         serial_flush
+ * Method description:  Blocks until the transmit ring buffer is empty
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void serial_flush();
+
+/**
+ * Method name:         serial_readByte
+ * Method description:  Takes one received byte from the queue, returns immediately
+ * Input params:        pcByte = Where the byte is stored
+ * Output params:       int = 1 if a byte was read, 0 if the queue was empty
+ */
+int serial_readByte(char *pcByte);
+
+/**
+ * Method name:         serial_getTxDroppedMessages
+ * Method description:  Returns how many messages were dropped because the buffer was full
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped messages
+ */
+uint32_t serial_getTxDroppedMessages();
+
+/**
+ * Method name:         serial_getTxDroppedBytes
+ * Method description:  Returns how many bytes were dropped because the buffer was full
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped bytes
+ */
+uint32_t serial_getTxDroppedBytes();
+
+/**
+ * Method name:         serial_getRxDroppedBytes
+ * Method description:  Returns how many received bytes were lost, either because the
+ *                      queue was full or because of a UART overrun
+ * Input params:        n/a
+ * Output params:       uint32_t = Dropped bytes
+ */
+uint32_t serial_getRxDroppedBytes();
+
+/**
+ * Method name:         UART0_IRQHandler
+ * Method description:  UART0 IRQ handler, fills the receive queue and drains the transmit ring buffer
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+extern void UART0_IRQHandler();
+
+#endif /* SOURCES_SERIAL_H_ */
@@ -9,7 +9,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       25Jun2016
- * Revision date:       25Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -24,13 +24,112 @@
 #define GPIO_INPUT                  0x00U
 #define GPIO_OUTPUT                 0x01U
 
+/* Core clock, set up by mcg_clockInit */
+#define CORE_CLOCK_MHZ              40U
+
 /* Project specific definitions */
-#define CONST_2PI                   2 * 3.14159
-#define MAX_MOTOR_VELOCITY_RAD      2100*CONST_2PI/60
+#define CONST_2PI                   (2 * 3.14159)
+#define MAX_MOTOR_VELOCITY_RAD      (2100*CONST_2PI/60)
+/* H-bridge supply, scales the voltage feedforward to duty */
+#define MOTOR_SUPPLY_MV             12000
+
+/* Scheduler tick period in microseconds, LPTMR on the 1kHz LPO */
+/* 1ms */
+#define SCHEDULER_TICK_PERIOD           1000
 
-/* Cyclic executive period in microseconds */
-/* 20ms */
+/* Task periods in microseconds, multiples of SCHEDULER_TICK_PERIOD */
+/* Control task: encoder, PID and PWM. The gains are tuned for 20ms */
 #define CYCLIC_EXECUTIVE_PERIOD         20 * 1000
+/* Control task context */
+/* Main loop, sampled whenever the loop gets to it after the higher priority work */
+#define CONTROL_MODE_TASK               0
+/* Tick ISR: encoder sample, PID and PWM write at a fixed latency from the tick */
+#define CONTROL_MODE_ISR                1
+#define CONTROL_MODE                    CONTROL_MODE_ISR
+
+/* Host command parsing, 50Hz */
+#define HMI_RECEIVE_TASK_PERIOD         20 * 1000
+/* Telemetry default, changed by the host with the 'e' command */
+#define TELEMETRY_TASK_PERIOD           20 * 1000
+/* Drop telemetry released before a late tick to protect the control deadline, 'o' changes it */
+#define SCHEDULER_SHEDDING              0
+
+/* Controller engine selection */
+/* Double precision, soft-float on the Cortex-M0+ */
+#define CONTROLLER_ENGINE_DOUBLE        0
+/* Q16.16 fixed point, saturating integer arithmetic */
+#define CONTROLLER_ENGINE_Q16           1
+#define CONTROLLER_ENGINE               CONTROLLER_ENGINE_Q16
+
+/* Backend of the fixed-point kernels (Q16.16 PID and Q31 filters) */
+/* Portable C, also built by the SIL */
+#define DSP_BACKEND_C                   0
+/* CMSIS-DSP arm_pid_q31 and arm_biquad_cascade_df1_q31, target only: links libarm_cortexM0l_math.a */
+#define DSP_BACKEND_CMSIS               1
+#define DSP_BACKEND                     DSP_BACKEND_C
+
+/* Control structure */
+/* Velocity PID straight to the PWM duty */
+#define CONTROL_LOOP_VELOCITY           0
+/* Velocity PID sets the current reference of a PI current loop run at the PWM rate. Needs the */
+/* current sense amplifier on PTB0/ADC0_SE8 (see Current Sense Definitions), which the bench */
+/* rig does not have: without it the loop drives the bridge from a floating ADC pin */
+#define CONTROL_LOOP_CASCADE            1
+/* CONTROL_LOOP_CASCADE only once the sensor is fitted */
+#define CONTROL_LOOP                    CONTROL_LOOP_VELOCITY
+/* NVIC priorities (0 highest, 3 lowest). Encoder edges come every ~7us at full speed and a second */
+/* edge on a channel overwrites its capture, so the capture ISR preempts the current loop, which */
+/* preempts the scheduler tick (control task) */
+#define ENCODER_CAPTURE_IRQ_PRIORITY    0
+#define CURRENT_LOOP_IRQ_PRIORITY       1
+#define SCHEDULER_TICK_IRQ_PRIORITY     2
+/* Profile the encoder capture ISR (worst case in the 'r' report), costs about 70 cycles per edge */
+#define PROFILER_ENCODER_CAPTURE        1
+
+/* Velocity references below this turn the controller off, in rad/s */
+#define VELOCITY_MIN_REFERENCE_RAD      20
+
+/* Velocity fed to the controller, changed by the host with the 'q' command */
+/* Encoder count over the last window */
+#define VELOCITY_SOURCE_ENCODER         0
+/* Alpha-beta-gamma observer on the encoder position, no lag on ramps */
+#define VELOCITY_SOURCE_OBSERVER        1
+#define VELOCITY_SOURCE                 VELOCITY_SOURCE_OBSERVER
+/* Observer memory per control period, 0 < theta < 1: lower tracks faster, higher smooths more */
+#define OBSERVER_THETA                  0.5
+
+/* Filters of the control path, designs of the filter coefficient table (t_FILTER_Design). Changed by the host */
+/* with the 'f' (measured velocity), 'h' (derivative term) and 'x' (actuator command) commands */
+#define VELOCITY_FILTER                 FILTER_DESIGN_NONE
+#define DERIVATIVE_FILTER               FILTER_DESIGN_LOWPASS_1ST
+#define ACTUATOR_FILTER                 FILTER_DESIGN_NONE
+
+/* Model-based feedforward of the shaped velocity reference, motor set of the feedforward table (t_FEEDFORWARD_Set). */
+/* Changed by the host with the 'k' (set), 'u', 's', 'z' (friction and inertia currents) and 'y' (back-EMF) commands */
+#define FEEDFORWARD_SET                 FEEDFORWARD_SET_NOMINAL
+
+/* Velocity reference shaping, changed by the host with the 'a' and 'j' commands, 0 disables */
+/* Slew rate limit, rad/s^2 */
+#define REFERENCE_MAX_ACCELERATION      100
+/* Jerk limit, rad/s^3, also smooths the position mode trapezoid into an S-curve */
+#define REFERENCE_MAX_JERK              1000
+
+/* Position mode ('g' command): S-curve trajectory feeding a P position loop, which sets the velocity reference */
+/* Profile limits at startup, changed by the host with the 'm' and 'n' commands */
+#define POSITION_MAX_VELOCITY_DPS       3600
+#define POSITION_MAX_ACCELERATION_DPS2  3600
+/* Position loop gain, rad/s of velocity reference per rad of error */
+#define POSITION_KP                     4
+
+/* Idle mode between cyclic executive periods */
+/* Busy wait on the period flag */
+#define IDLE_MODE_SPIN                  0
+/* Wait: core clock gated, peripherals keep running */
+#define IDLE_MODE_WAIT                  1
+/* VLPS: also stops the bus clock, so UART0, PWM and the encoder TPMs stop */
+/* while idle. Only the LPTMR (LPO clock) wakes it. For power tests only */
+#define IDLE_MODE_VLPS                  2
+#define IDLE_MODE                       IDLE_MODE_WAIT
 
 
 
@@ -67,7 +166,7 @@
 
 
 /*                     Encoder Definitions               */
-/* ChA: PTC12(J2 01) @ FTM_CLKIN0, TPM1 for encoder pin A */
+/* ChA: PTC12(J2 01) @ FTM_CLKIN0, TPM2 counts encoder pin A pulses */
 #define ENCODER_CHA_PORT_INSTANCE       PORTC_IDX
 #define ENCODER_CHA_PORT_BASE           PORTC
 #define ENCODER_CHA_PORT_ALT            4U
@@ -75,14 +174,23 @@
 #define ENCODER_CHA_TPM_INSTANCE        TPM2_IDX
 #define ENCODER_CHA_TPM_BASE            TPM2
 #define ENCODER_CHA_FTM_CLKIN           0U
-/* ChB:  PTC13(J2 03) @ FTM_CLKIN1, TPM2 for encoder pin B */
-#define ENCODER_CHB_PORT_INSTANCE       PORTC_IDX
-#define ENCODER_CHB_PORT_BASE           PORTC
-#define ENCODER_CHB_PORT_ALT            4U
-#define ENCODER_CHB_PIN_NUMBER          13U
-#define ENCODER_CHB_TPM_INSTANCE        TPM1_IDX
-#define ENCODER_CHB_TPM_BASE            TPM1
-#define ENCODER_CHB_FTM_CLKIN           1U
+/* Capture timer: TPM1, free running from the module clock */
+#define ENCODER_CAPTURE_TPM_INSTANCE    TPM1_IDX
+#define ENCODER_CAPTURE_TPM_BASE        TPM1
+/* ChA capture: PTE20(J10 01) @ TPM1_CH0, wired to encoder pin A as well */
+#define ENCODER_CAPA_PORT_INSTANCE      PORTE_IDX
+#define ENCODER_CAPA_PORT_BASE          PORTE
+#define ENCODER_CAPA_GPIO_BASE          GPIOE
+#define ENCODER_CAPA_PORT_ALT           3U
+#define ENCODER_CAPA_PIN_NUMBER         20U
+#define ENCODER_CAPA_CHANNEL            0U
+/* ChB: PTE21(J10 03) @ TPM1_CH1 */
+#define ENCODER_CHB_PORT_INSTANCE       PORTE_IDX
+#define ENCODER_CHB_PORT_BASE           PORTE
+#define ENCODER_CHB_GPIO_BASE           GPIOE
+#define ENCODER_CHB_PORT_ALT            3U
+#define ENCODER_CHB_PIN_NUMBER          21U
+#define ENCODER_CHB_CHANNEL             1U
 /* ChO:  PTD0(J2 06) interrupt pin */
 #define ENCODER_CHO_PORT_INSTANCE       PORTD_IDX
 #define ENCODER_CHO_PORT_BASE           PORTD
@@ -93,6 +201,8 @@
 #define ENCODER_CHA_IRQN                TPM2_IRQn
 #define ENCODER_CHO_IRQ_HANDLER         PORTD_IRQHandler
 #define ENCODER_CHO_IRQn                PORTD_IRQn
+#define ENCODER_CAPTURE_IRQ_HANDLER     TPM1_IRQHandler
+#define ENCODER_CAPTURE_IRQn            TPM1_IRQn
 
 /*                  END OF Encoder Definitions           */
 
@@ -108,6 +218,37 @@
 
 /*                   END OF HMI Definitions              */
 
+/*                 Current Sense Definitions             */
+/* Bidirectional current sense amplifier on the bridge output, biased at VREFH/2 */
+/* Sense: PTB0 (J10 02), ADC0_SE8 */
+#define CURRENT_PORT_INSTANCE           PORTB_IDX
+#define CURRENT_PORT_BASE               PORTB
+#define CURRENT_PORT_ALT                0U
+#define CURRENT_PIN_NUMBER              0U
+#define CURRENT_ADC_BASE                ADC0
+#define CURRENT_ADC_CHANNEL             8U
+/* ADC0 hardware trigger: TPM0 overflow, the PWM center in center-aligned mode */
+#define CURRENT_ADC_TRIGGER             8U
+/* DMA channel and its request source (ADC0) */
+#define CURRENT_DMA_BASE                DMA0
+#define CURRENT_DMA_CHANNEL             0U
+#define CURRENT_DMAMUX_BASE             DMAMUX0
+#define CURRENT_DMAMUX_SOURCE           40U
+#define CURRENT_DMA_IRQ_HANDLER         DMA0_IRQHandler
+#define CURRENT_DMA_IRQn                DMA0_IRQn
+/* Analog front end */
+#define CURRENT_ADC_VREF_MV             3300
+#define CURRENT_SENSE_ZERO_MV           1650
+#define CURRENT_SENSE_MV_PER_A          200
+/* Current loop: TPM0 overflow IRQ, decimated down to about this rate */
+#define CURRENT_LOOP_IRQ_HANDLER        TPM0_IRQHandler
+#define CURRENT_LOOP_IRQn               TPM0_IRQn
+#define CURRENT_LOOP_FREQUENCY          10000U
+/* Current reference limit at startup, changed by the host with the 'l' command */
+#define CURRENT_LIMIT_MA                2000
+
+/*              END OF Current Sense Definitions         */
+
 
 
 #endif /* SOURCES_TARGET_PINS_H_*/
@@ -0,0 +1,121 @@
+/**
+ *
+ * File name:           telemetry.c
+ * File description:    File containing the methods for the compact binary
+ *                      telemetry frames sent to the host. See telemetry.h
+ *                      for the frame layout.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "telemetry.h"
+
+/* CRC-16/CCITT-FALSE */
+#define TELEMETRY_CRC_INIT          0xFFFFU
+
+/* Nibble table for polynomial 0x1021: 32 bytes of flash instead of 512 */
+static const uint16_t uiTelemetryCrcTable[16] =
+{
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+
+/**
+ * Method name:         telemetry_crc16
+ * Method description:  Computes the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer
+ * Input params:        pucData = Buffer
+ *                      uiLength = Buffer length in bytes
+ * Output params:       uint16_t = CRC
+ */
+uint16_t telemetry_crc16(const uint8_t *pucData, uint32_t uiLength)
+{
+    uint16_t uiCrc = TELEMETRY_CRC_INIT;
+
+    while(uiLength--)
+    {
+        uiCrc = (uiCrc << 4) ^ uiTelemetryCrcTable[(uiCrc >> 12) ^ (*pucData >> 4)];
+        uiCrc = (uiCrc << 4) ^ uiTelemetryCrcTable[(uiCrc >> 12) ^ (*pucData & 0x0F)];
+        pucData++;
+    }
+    return uiCrc;
+}
+
+/**
+ * Method name:         telemetry_cobsEncode
+ * Method description:  Encodes a buffer with Consistent Overhead Byte Stuffing, so the
+ *                      output contains no 0x00. The delimiter is not appended.
+ * Input params:        pucInput = Buffer to be encoded
+ *                      uiLength = Buffer length in bytes, up to 254
+ *                      pucOutput = Encoded buffer, at least uiLength + 1 bytes
+ * Output params:       uint32_t = Encoded length in bytes
+ */
+uint32_t telemetry_cobsEncode(const uint8_t *pucInput, uint32_t uiLength, uint8_t *pucOutput)
+{
+    uint32_t uiCodeIndex = 0;
+    uint32_t uiOutIndex = 1;
+    uint8_t ucCode = 1;
+
+    while(uiLength--)
+    {
+        if(*pucInput)
+        {
+            pucOutput[uiOutIndex++] = *pucInput;
+            ucCode++;
+        }
+        else
+        {
+            /* Zero: close the current block */
+            pucOutput[uiCodeIndex] = ucCode;
+            uiCodeIndex = uiOutIndex++;
+            ucCode = 1;
+        }
+        pucInput++;
+    }
+    pucOutput[uiCodeIndex] = ucCode;
+
+    return uiOutIndex;
+}
+
+/**
+ * Method name:         telemetry_buildFrame
+ * Method description:  Builds a delimited frame
+ * Input params:        pucFrame = Output buffer, at least TELEMETRY_FRAME_MAX_SIZE bytes
+ *                      ucSequence = Sequence number, the telemetry period of the sample
+ *                      iVelocity = Velocity in 0.01 rad/s
+ *                      iPosition = Position in 0.01 degree
+ *                      iActuator = Actuator in 0.01 %
+ * Output params:       uint32_t = Frame length in bytes, delimiter included
+ */
+uint32_t telemetry_buildFrame(uint8_t *pucFrame, uint8_t ucSequence, int16_t iVelocity, int32_t iPosition, int16_t iActuator)
+{
+    uint8_t ucPayload[TELEMETRY_PAYLOAD_SIZE];
+    uint16_t uiCrc;
+    uint32_t uiLength;
+
+    /* Explicit little-endian packing, independent of struct layout */
+    ucPayload[0] = ucSequence;
+    ucPayload[1] = (uint8_t)iVelocity;
+    ucPayload[2] = (uint8_t)((uint16_t)iVelocity >> 8);
+    ucPayload[3] = (uint8_t)iPosition;
+    ucPayload[4] = (uint8_t)((uint32_t)iPosition >> 8);
+    ucPayload[5] = (uint8_t)((uint32_t)iPosition >> 16);
+    ucPayload[6] = (uint8_t)((uint32_t)iPosition >> 24);
+    ucPayload[7] = (uint8_t)iActuator;
+    ucPayload[8] = (uint8_t)((uint16_t)iActuator >> 8);
+    uiCrc = telemetry_crc16(ucPayload, TELEMETRY_PAYLOAD_SIZE - 2);
+    ucPayload[9] = (uint8_t)uiCrc;
+    ucPayload[10] = (uint8_t)(uiCrc >> 8);
+
+    uiLength = telemetry_cobsEncode(ucPayload, TELEMETRY_PAYLOAD_SIZE, pucFrame);
+    pucFrame[uiLength++] = 0x00;
+
+    return uiLength;
+}
@@ -0,0 +1,73 @@
+/**
+ *
+ * File name:           telemetry.h
+ * File description:    File containing the definition of methods for the
+ *                      compact binary telemetry frames sent to the host.
+ *
+ *                      Payload, little-endian, TELEMETRY_PAYLOAD_SIZE bytes:
+ *                      - uint8_t  sequence number, wraps at 255. It counts the
+ *                                 telemetry task releases, so a period lost to
+ *                                 a full TX buffer, shedding or an overrun shows
+ *                                 as a gap
+ *                      - int16_t  velocity in 0.01 rad/s
+ *                      - int32_t  position in 0.01 degree
+ *                      - int16_t  actuator in 0.01 %
+ *                      - uint16_t CRC-16/CCITT-FALSE of the fields above
+ *                      The payload is COBS encoded and terminated by a 0x00
+ *                      byte, so a frame is at most TELEMETRY_FRAME_MAX_SIZE
+ *                      bytes and the host can resynchronize on any 0x00.
+ *                      host_software/sysid/frame.c decodes them ('sysid -b').
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_TELEMETRY_H_
+#define SOURCES_TELEMETRY_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Fields plus CRC */
+#define TELEMETRY_PAYLOAD_SIZE      11
+/* COBS adds one byte per 254 payload bytes, plus the 0x00 delimiter */
+#define TELEMETRY_FRAME_MAX_SIZE    (TELEMETRY_PAYLOAD_SIZE + 2)
+
+/**
+ * Method name:         telemetry_crc16
+ * Method description:  Computes the CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) of a buffer
+ * Input params:        pucData = Buffer
+ *                      uiLength = Buffer length in bytes
+ * Output params:       uint16_t = CRC
+ */
+uint16_t telemetry_crc16(const uint8_t *pucData, uint32_t uiLength);
+
+/**
+ * Method name:         telemetry_cobsEncode
+ * Method description:  Encodes a buffer with Consistent Overhead Byte Stuffing, so the
+ *                      output contains no 0x00. The delimiter is not appended.
+ * Input params:        pucInput = Buffer to be encoded
+ *                      uiLength = Buffer length in bytes, up to 254
+ *                      pucOutput = Encoded buffer, at least uiLength + 1 bytes
+ * Output params:       uint32_t = Encoded length in bytes
+ */
+uint32_t telemetry_cobsEncode(const uint8_t *pucInput, uint32_t uiLength, uint8_t *pucOutput);
+
+/**
+ * Method name:         telemetry_buildFrame
+ * Method description:  Builds a delimited frame
+ * Input params:        pucFrame = Output buffer, at least TELEMETRY_FRAME_MAX_SIZE bytes
+ *                      ucSequence = Sequence number, the telemetry period of the sample
+ *                      iVelocity = Velocity in 0.01 rad/s
+ *                      iPosition = Position in 0.01 degree
+ *                      iActuator = Actuator in 0.01 %
+ * Output params:       uint32_t = Frame length in bytes, delimiter included
+ */
+uint32_t telemetry_buildFrame(uint8_t *pucFrame, uint8_t ucSequence, int16_t iVelocity, int32_t iPosition, int16_t iActuator);
+
+#endif /* SOURCES_TELEMETRY_H_ */
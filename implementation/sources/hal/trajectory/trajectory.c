@@ -0,0 +1,321 @@
+/**
+ *
+ * File name:           trajectory.c
+ * File description:    File containing the methods for the S-curve
+ *                      position trajectory generator.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+/* Project includes */
+#include "trajectory.h"
+#include "hal/target_definitions.h"
+#include "hal/encoder/encoder.h"
+#include "hal/controller/controller.h"
+
+/* Control periods per second, the profile advances once per period */
+#define TRAJECTORY_PERIODS_PER_SECOND   (1000000/(CYCLIC_EXECUTIVE_PERIOD))
+/* Counts per period to rad/s, Q16.16 */
+#define TRAJECTORY_COUNTS_TO_RAD_Q16    CONTROLLER_Q16(CONST_2PI*TRAJECTORY_PERIODS_PER_SECOND/ENCODER_QUADRATURE_COUNT)
+/* Rad/s to counts per period, Q16.16 */
+#define TRAJECTORY_RAD_TO_COUNTS_Q16    CONTROLLER_Q16(ENCODER_QUADRATURE_COUNT/(CONST_2PI*TRAJECTORY_PERIODS_PER_SECOND))
+/* Bound of host values in degrees, keeps the conversions within 64 bits */
+#define TRAJECTORY_MAX_DEGREES          1000000
+/* Bound of velocity and acceleration, keeps v*(v + a) within 64 bits */
+#define TRAJECTORY_MAX_RATE_Q16         (1L << 30)
+/* Bound of the host jerk, keeps its conversion within 64 bits */
+#define TRAJECTORY_MAX_JERK_RAD         1000000000L
+
+/**
+ * Method name:         trajectory_clamp
+ * Method description:  Limits a value to [-llLimit, llLimit]
+ * Input params:        llValue = Value
+ *                      llLimit = Limit, positive
+ * Output params:       int64_t = Limited value
+ */
+static int64_t trajectory_clamp(int64_t llValue, int64_t llLimit)
+{
+    if(llValue > llLimit)
+        return llLimit;
+    if(llValue < -llLimit)
+        return -llLimit;
+    return llValue;
+}
+
+/**
+ * Method name:         trajectory_degreesToCountsQ16
+ * Method description:  Converts degrees to quadrature counts
+ * Input params:        iDegrees = Degrees, or degrees per second, or per second squared
+ *                      iPeriods = Periods per second, once per time unit, or 1
+ * Output params:       int64_t = Counts per period to the same power, Q16.16
+ */
+static int64_t trajectory_degreesToCountsQ16(int32_t iDegrees, int32_t iPeriods)
+{
+    int64_t llDegrees = trajectory_clamp(iDegrees, TRAJECTORY_MAX_DEGREES);
+
+    return (llDegrees*ENCODER_QUADRATURE_COUNT*CONTROLLER_Q16_ONE)/(360*(int64_t)iPeriods);
+}
+
+/**
+ * Method name:         trajectory_requestWindow
+ * Method description:  Computes the window length that keeps the jerk of the limits set
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+static void trajectory_requestWindow(t_TRAJECTORY_Profile *trajectory)
+{
+    int64_t llWindow = 1;
+
+    /* Averaging over n periods spreads each acceleration step over n periods */
+    if(trajectory->iMaxJerk > 0)
+        llWindow = ((int64_t)trajectory->iMaxAcceleration + trajectory->iMaxJerk - 1)/trajectory->iMaxJerk;
+    if(llWindow < 1)
+        llWindow = 1;
+    trajectory->iWindowRequest = (int)((llWindow > TRAJECTORY_MAX_WINDOW) ? TRAJECTORY_MAX_WINDOW : llWindow);
+}
+
+/**
+ * Method name:         trajectory_fillWindow
+ * Method description:  Applies the requested window length and fills it as if the trapezoid had
+ *                      moved at its current velocity, so the output holds llPosition and iVelocity
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      llPosition = Output position, counts in Q16.16
+ * Output params:       n/a
+ */
+static void trajectory_fillWindow(t_TRAJECTORY_Profile *trajectory, int64_t llPosition)
+{
+    int iWindow = trajectory->iWindowRequest;
+    int i;
+
+    /* The trapezoid leads the average by half the window */
+    trajectory->llPosition = llPosition + ((int64_t)trajectory->iVelocity*(iWindow - 1))/2;
+    trajectory->llWindowSum = 0;
+    for(i = 0; i < iWindow; i++)
+    {
+        trajectory->llWindow[i] = trajectory->llPosition - (int64_t)trajectory->iVelocity*(iWindow - 1 - i);
+        trajectory->llWindowSum += trajectory->llWindow[i];
+    }
+    trajectory->iWindow = iWindow;
+    trajectory->iHead = iWindow - 1;
+    trajectory->llOutputPosition = trajectory->llWindowSum/iWindow;
+    trajectory->iOutputVelocity = trajectory->iVelocity;
+}
+
+/**
+ * Method name:         trajectory_initTrajectory
+ * Method description:  Loads the POSITION_* limits and the REFERENCE_MAX_JERK jerk, and holds position 0
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+void trajectory_initTrajectory(t_TRAJECTORY_Profile *trajectory)
+{
+    trajectory_setMaxVelocityDegrees(trajectory, POSITION_MAX_VELOCITY_DPS);
+    trajectory_setMaxAccelerationDegrees(trajectory, POSITION_MAX_ACCELERATION_DPS2);
+    trajectory_setMaxJerkRad(trajectory, REFERENCE_MAX_JERK);
+    trajectory_start(trajectory, 0, 0);
+}
+
+/**
+ * Method name:         trajectory_start
+ * Method description:  Restarts the profile from the measured state, so the reference does not jump
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      llCount = Position in quadrature counts
+ *                      iVelocityRadQ16 = Velocity in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void trajectory_start(t_TRAJECTORY_Profile *trajectory, int64_t llCount, int32_t iVelocityRadQ16)
+{
+    trajectory->llTarget = llCount*CONTROLLER_Q16_ONE;
+    trajectory->iVelocity = (int32_t)trajectory_clamp(((int64_t)iVelocityRadQ16*TRAJECTORY_RAD_TO_COUNTS_Q16) >> CONTROLLER_Q16_SHIFT,
+            TRAJECTORY_MAX_RATE_Q16);
+    trajectory_fillWindow(trajectory, trajectory->llTarget);
+    trajectory->iProfileDone = 0;
+    trajectory->iDone = 0;
+}
+
+/**
+ * Method name:         trajectory_setTargetDegrees
+ * Method description:  Sets the final position
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegrees = Position in degrees, multi-turn, from the position at power up
+ * Output params:       n/a
+ */
+void trajectory_setTargetDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegrees)
+{
+    /* At rest the window holds one value, a new length can be applied without a jump */
+    if(trajectory->iDone)
+        trajectory_fillWindow(trajectory, trajectory->llOutputPosition);
+    trajectory->llTarget = trajectory_degreesToCountsQ16(iDegrees, 1);
+    trajectory->iProfileDone = 0;
+    trajectory->iDone = 0;
+}
+
+/**
+ * Method name:         trajectory_setMaxVelocityDegrees
+ * Method description:  Sets the velocity limit
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegreesPerSecond = Velocity limit in degrees/s
+ * Output params:       n/a
+ */
+void trajectory_setMaxVelocityDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegreesPerSecond)
+{
+    int64_t llVelocity = trajectory_degreesToCountsQ16(iDegreesPerSecond, TRAJECTORY_PERIODS_PER_SECOND);
+
+    trajectory->iMaxVelocity = (int32_t)trajectory_clamp(llVelocity < 0 ? -llVelocity : llVelocity, TRAJECTORY_MAX_RATE_Q16);
+}
+
+/**
+ * Method name:         trajectory_setMaxAccelerationDegrees
+ * Method description:  Sets the acceleration limit, also used to brake
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegreesPerSecond2 = Acceleration limit in degrees/s^2
+ * Output params:       n/a
+ */
+void trajectory_setMaxAccelerationDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegreesPerSecond2)
+{
+    int64_t llAcceleration = trajectory_degreesToCountsQ16(iDegreesPerSecond2,
+            TRAJECTORY_PERIODS_PER_SECOND*TRAJECTORY_PERIODS_PER_SECOND);
+
+    if(llAcceleration < 0)
+        llAcceleration = -llAcceleration;
+    /* Zero would never brake */
+    if(!llAcceleration)
+        llAcceleration = 1;
+    trajectory->iMaxAcceleration = (int32_t)trajectory_clamp(llAcceleration, TRAJECTORY_MAX_RATE_Q16);
+    trajectory_requestWindow(trajectory);
+}
+
+/**
+ * Method name:         trajectory_setMaxJerkRad
+ * Method description:  Sets the jerk limit
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iRadPerSecond3 = Jerk limit in rad/s^3, 0 leaves the trapezoid unsmoothed
+ * Output params:       n/a
+ */
+void trajectory_setMaxJerkRad(t_TRAJECTORY_Profile *trajectory, int32_t iRadPerSecond3)
+{
+    int64_t llJerk = trajectory_clamp(iRadPerSecond3, TRAJECTORY_MAX_JERK_RAD);
+
+    if(llJerk < 0)
+        llJerk = -llJerk;
+    /* rad/s^3 is rad/s per s^2, the per-period velocity changes per period squared */
+    llJerk = (llJerk*TRAJECTORY_RAD_TO_COUNTS_Q16)/((int64_t)TRAJECTORY_PERIODS_PER_SECOND*TRAJECTORY_PERIODS_PER_SECOND);
+    /* A nonzero limit below the resolution still smooths, over the longest window */
+    if(iRadPerSecond3 && !llJerk)
+        llJerk = 1;
+    trajectory->iMaxJerk = (int32_t)trajectory_clamp(llJerk, TRAJECTORY_MAX_RATE_Q16);
+    trajectory_requestWindow(trajectory);
+}
+
+/**
+ * Method name:         trajectory_updateTrapezoid
+ * Method description:  Advances the trapezoid by one control period
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+static void trajectory_updateTrapezoid(t_TRAJECTORY_Profile *trajectory)
+{
+    int64_t llDistance = trajectory->llTarget - trajectory->llPosition;
+    int32_t iAcceleration = trajectory->iMaxAcceleration;
+    int32_t iDirection = 1;
+    int32_t iSpeed;
+
+    /* Work on the distance and speed towards the target, the speed is negative moving away */
+    if(llDistance < 0)
+    {
+        iDirection = -1;
+        llDistance = -llDistance;
+    }
+    iSpeed = iDirection*trajectory->iVelocity;
+
+    /* Braking from iSpeed by iAcceleration per period covers iSpeed*(iSpeed + iAcceleration)/(2*iAcceleration) */
+    if((iSpeed > 0) && (((int64_t)iSpeed*(iSpeed + iAcceleration))/(2*iAcceleration) >= llDistance))
+        iSpeed = (iSpeed > iAcceleration) ? (iSpeed - iAcceleration) : 0;
+    else if(iSpeed < trajectory->iMaxVelocity)
+        iSpeed = (iSpeed < trajectory->iMaxVelocity - iAcceleration) ? (iSpeed + iAcceleration) : trajectory->iMaxVelocity;
+    /* Limit lowered while cruising */
+    else if(iSpeed > trajectory->iMaxVelocity)
+        iSpeed = (iSpeed - iAcceleration > trajectory->iMaxVelocity) ? (iSpeed - iAcceleration) : trajectory->iMaxVelocity;
+
+    /* Within one slow step of the target */
+    if((llDistance <= iSpeed) && (iSpeed <= iAcceleration))
+    {
+        trajectory->llPosition = trajectory->llTarget;
+        trajectory->iVelocity = 0;
+        trajectory->iProfileDone = 1;
+        return;
+    }
+
+    trajectory->iVelocity = iDirection*iSpeed;
+    trajectory->llPosition += trajectory->iVelocity;
+}
+
+/**
+ * Method name:         trajectory_update
+ * Method description:  Advances the profile by one control period
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+void trajectory_update(t_TRAJECTORY_Profile *trajectory)
+{
+    int64_t llPrevious = trajectory->llOutputPosition;
+
+    if(trajectory->iDone)
+        return;
+
+    if(!trajectory->iProfileDone)
+        trajectory_updateTrapezoid(trajectory);
+
+    /* Moving average of the trapezoid, the oldest entry is replaced by the newest */
+    trajectory->iHead = (trajectory->iHead + 1 < trajectory->iWindow) ? (trajectory->iHead + 1) : 0;
+    trajectory->llWindowSum += trajectory->llPosition - trajectory->llWindow[trajectory->iHead];
+    trajectory->llWindow[trajectory->iHead] = trajectory->llPosition;
+    trajectory->llOutputPosition = trajectory->llWindowSum/trajectory->iWindow;
+    trajectory->iOutputVelocity = (int32_t)trajectory_clamp(trajectory->llOutputPosition - llPrevious, TRAJECTORY_MAX_RATE_Q16);
+
+    /* Exact once the whole window holds the target */
+    if(trajectory->iProfileDone && (trajectory->llOutputPosition == trajectory->llTarget))
+    {
+        trajectory->iOutputVelocity = 0;
+        trajectory->iDone = 1;
+    }
+}
+
+/**
+ * Method name:         trajectory_getPositionCount
+ * Method description:  Returns the reference position
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int64_t = Position in quadrature counts
+ */
+int64_t trajectory_getPositionCount(const t_TRAJECTORY_Profile *trajectory)
+{
+    return trajectory->llOutputPosition >> CONTROLLER_Q16_SHIFT;
+}
+
+/**
+ * Method name:         trajectory_getVelocityRadQ16
+ * Method description:  Returns the reference velocity, the feedforward of the position loop
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int32_t = Velocity in rad/s, Q16.16
+ */
+int32_t trajectory_getVelocityRadQ16(const t_TRAJECTORY_Profile *trajectory)
+{
+    return (int32_t)(((int64_t)trajectory->iOutputVelocity*TRAJECTORY_COUNTS_TO_RAD_Q16) >> CONTROLLER_Q16_SHIFT);
+}
+
+/**
+ * Method name:         trajectory_isDone
+ * Method description:  Returns whether the target was reached
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int = 1 once the reference holds the target
+ */
+int trajectory_isDone(const t_TRAJECTORY_Profile *trajectory)
+{
+    return trajectory->iDone;
+}
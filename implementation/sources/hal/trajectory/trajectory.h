@@ -0,0 +1,172 @@
+/**
+ *
+ * File name:           trajectory.h
+ * File description:    File containing the definition of methods for the
+ *                      S-curve position trajectory generator.
+ *
+ *                      - Positions are encoder quadrature counts, velocities
+ *                        and accelerations are per control period, all in
+ *                        integer Q16.16 (position in 64 bits).
+ *                      - trajectory_update advances a trapezoid by one
+ *                        control period with adds, one multiply and one
+ *                        division, no floating point. It brakes as soon as
+ *                        the stopping distance reaches the distance left, so
+ *                        targets and limits can change while moving.
+ *                      - The trapezoid is then smoothed by a moving average
+ *                        of its positions over a/j periods (one more
+ *                        division), which turns it into a jerk-limited
+ *                        S-curve with the same velocity and acceleration
+ *                        limits, delayed by half the window. The jerk is
+ *                        a/window, twice that where the trapezoid goes
+ *                        straight from accelerating to braking (short moves)
+ *                        or the reverse (its last step onto the target).
+ *                        Windows are capped at TRAJECTORY_MAX_WINDOW periods
+ *                        and a new length applies once the profile is at
+ *                        rest.
+ *                      - Units from the host (degrees, rad/s^3 for the jerk
+ *                        shared with the velocity ramp) are converted once,
+ *                        when they are set.
+ *
+ * Authors:             Bruno de Souza Ferreira
+ *                      Guilherme Kairalla Kolotelo
+ *                      Guilherme Bersi Pereira
+ *
+ * Creation date:       18Oct2026
+ * Revision date:       18Oct2026
+ *
+ */
+
+#ifndef SOURCES_TRAJECTORY_H_
+#define SOURCES_TRAJECTORY_H_
+
+/* System includes */
+#include <stdint.h>
+
+/* Longest smoothing window, in control periods */
+#define TRAJECTORY_MAX_WINDOW       32
+
+/**
+ * Type name:           t_TRAJECTORY_Profile
+ * Method description:  Struct containing the limits and state of a trajectory
+ * Params:              llPosition:             Trapezoid position, counts in Q16.16
+ *                      llTarget:               Final position, counts in Q16.16
+ *                      iVelocity:              Trapezoid velocity, counts per period in Q16.16
+ *                      iMaxVelocity:           Velocity limit, counts per period in Q16.16
+ *                      iMaxAcceleration:       Acceleration limit, counts per period squared in Q16.16
+ *                      iMaxJerk:               Jerk limit, counts per period cubed in Q16.16, 0 for none
+ *                      llWindow:               Last trapezoid positions, ring buffer
+ *                      llWindowSum:            Sum of the window
+ *                      iWindow:                Window length in use, periods
+ *                      iWindowRequest:         Window length for the limits set, applied at rest
+ *                      iHead:                  Newest window entry
+ *                      llOutputPosition:       Reference position, counts in Q16.16
+ *                      iOutputVelocity:        Reference velocity, counts per period in Q16.16
+ *                      iProfileDone:           Trapezoid at the target, the window still draining
+ *                      iDone:                  Target reached and held
+ */
+typedef struct
+{
+    int64_t llPosition;
+    int64_t llTarget;
+    int32_t iVelocity;
+    int32_t iMaxVelocity;
+    int32_t iMaxAcceleration;
+    int32_t iMaxJerk;
+    int64_t llWindow[TRAJECTORY_MAX_WINDOW];
+    int64_t llWindowSum;
+    int iWindow;
+    int iWindowRequest;
+    int iHead;
+    int64_t llOutputPosition;
+    int32_t iOutputVelocity;
+    int iProfileDone;
+    int iDone;
+} t_TRAJECTORY_Profile;
+
+/**
+ * Method name:         trajectory_initTrajectory
+ * Method description:  Loads the POSITION_* limits and the REFERENCE_MAX_JERK jerk, and holds position 0
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+void trajectory_initTrajectory(t_TRAJECTORY_Profile *trajectory);
+
+/**
+ * Method name:         trajectory_start
+ * Method description:  Restarts the profile from the measured state, so the reference does not jump
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      llCount = Position in quadrature counts
+ *                      iVelocityRadQ16 = Velocity in rad/s, Q16.16
+ * Output params:       n/a
+ */
+void trajectory_start(t_TRAJECTORY_Profile *trajectory, int64_t llCount, int32_t iVelocityRadQ16);
+
+/**
+ * Method name:         trajectory_setTargetDegrees
+ * Method description:  Sets the final position
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegrees = Position in degrees, multi-turn, from the position at power up
+ * Output params:       n/a
+ */
+void trajectory_setTargetDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegrees);
+
+/**
+ * Method name:         trajectory_setMaxVelocityDegrees
+ * Method description:  Sets the velocity limit
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegreesPerSecond = Velocity limit in degrees/s
+ * Output params:       n/a
+ */
+void trajectory_setMaxVelocityDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegreesPerSecond);
+
+/**
+ * Method name:         trajectory_setMaxAccelerationDegrees
+ * Method description:  Sets the acceleration limit, also used to brake
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iDegreesPerSecond2 = Acceleration limit in degrees/s^2
+ * Output params:       n/a
+ */
+void trajectory_setMaxAccelerationDegrees(t_TRAJECTORY_Profile *trajectory, int32_t iDegreesPerSecond2);
+
+/**
+ * Method name:         trajectory_setMaxJerkRad
+ * Method description:  Sets the jerk limit
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ *                      iRadPerSecond3 = Jerk limit in rad/s^3, 0 leaves the trapezoid unsmoothed
+ * Output params:       n/a
+ */
+void trajectory_setMaxJerkRad(t_TRAJECTORY_Profile *trajectory, int32_t iRadPerSecond3);
+
+/**
+ * Method name:         trajectory_update
+ * Method description:  Advances the profile by one control period
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       n/a
+ */
+void trajectory_update(t_TRAJECTORY_Profile *trajectory);
+
+/**
+ * Method name:         trajectory_getPositionCount
+ * Method description:  Returns the reference position
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int64_t = Position in quadrature counts
+ */
+int64_t trajectory_getPositionCount(const t_TRAJECTORY_Profile *trajectory);
+
+/**
+ * Method name:         trajectory_getVelocityRadQ16
+ * Method description:  Returns the reference velocity, the feedforward of the position loop
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int32_t = Velocity in rad/s, Q16.16
+ */
+int32_t trajectory_getVelocityRadQ16(const t_TRAJECTORY_Profile *trajectory);
+
+/**
+ * Method name:         trajectory_isDone
+ * Method description:  Returns whether the target was reached
+ * Input params:        trajectory = t_TRAJECTORY_Profile struct
+ * Output params:       int = 1 once the reference holds the target
+ */
+int trajectory_isDone(const t_TRAJECTORY_Profile *trajectory);
+
+#endif /* SOURCES_TRAJECTORY_H_ */
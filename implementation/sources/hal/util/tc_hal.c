@@ -22,7 +22,8 @@ lptmr_user_config_t lptmrConfig =
 {
     .timerMode              = kLptmrTimerModeTimeCounter,
     .freeRunningEnable      = false,
-    .prescalerEnable        = true,
+    /* Prescaler bypassed: 1ms resolution for the scheduler tick */
+    .prescalerEnable        = false,
     .prescalerClockSource   = kClockLptmrSrcLpoClk,
     .prescalerValue         = kLptmrPrescalerDivide2,
     .isInterruptEnabled     = true,
@@ -8,7 +8,7 @@
  *                      Guilherme Bersi Pereira
  *
  * Creation date:       20Jun2016
- * Revision date:       27Jun2016
+ * Revision date:       18Oct2026
  *
  */
 
@@ -16,6 +16,7 @@
 #include "fsl_clock_manager.h"
 #include "fsl_port_hal.h"
 #include "fsl_gpio_hal.h"
+#include "fsl_smc_hal.h"
 
 /* Project includes */
 #include "hal/target_definitions.h"
@@ -23,8 +24,16 @@
 #include "hal/util/tc_hal.h"
 #include "hal/encoder/encoder.h"
 #include "hal/driver/driver.h"
+#include "hal/current/current.h"
 #include "hal/controller/controller.h"
+#include "hal/filter/filter.h"
+#include "hal/observer/observer.h"
+#include "hal/feedforward/feedforward.h"
 #include "hal/hmi/hmi.h"
+#include "hal/profiler/profiler.h"
+#include "hal/scheduler/scheduler.h"
+#include "hal/trajectory/trajectory.h"
+#include "hal/ramp/ramp.h"
 
 /* Globals */
 
@@ -39,18 +48,287 @@ double dSensorVelocity = 0, dSensorPosition = 0;
 /* Reference variables */
 double dReferenceVelocity = 40;
 /* Controller variables */
-double dKp = 17, dKi = 1.2, dKd = 0, dMaxSumError = 100, dActuatorValue = 0, dErrorCurrent = 0;
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+/* Velocity loop output is the current reference, in A */
+double dKp = 0.22, dKi = 0.022, dKd = 0, dMaxSumError = 100, dActuatorValue = 0, dErrorCurrent = 0;
+#else
+double dKp = 12, dKi = 1.5, dKd = 0, dMaxSumError = 100, dActuatorValue = 0, dErrorCurrent = 0;
+#endif
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+/* Fixed-point controller variables, in Q16.16 */
+/* Controller output to actuator percentage: 100/MAX_MOTOR_VELOCITY_RAD */
+#define MAIN_ACTUATOR_SCALE_Q16     CONTROLLER_Q16(100/(MAX_MOTOR_VELOCITY_RAD))
+/* Actuator percentage to controller output, for the feedforward: MAX_MOTOR_VELOCITY_RAD/100 */
+#define MAIN_ACTUATOR_UNSCALE_Q16   CONTROLLER_Q16((MAX_MOTOR_VELOCITY_RAD)/100)
+int32_t iSensorVelocityQ16 = 0, iActuatorValueQ16 = 0, iCurrentReferenceQ16 = 0;
+int32_t iReferenceVelocityQ16 = CONTROLLER_INT_TO_Q16(40), iShapedVelocityQ16 = 0;
+t_PID_Q16 pidDataQ16;
+#else
+double dCurrentReference = 0, dShapedVelocity = 0;
 t_PID_Data pidData;
+#endif
+
+/* Position mode, entered with 'g' and left with 'v' */
+/* Position loop gain, rad/s per quadrature count of error */
+#define MAIN_POSITION_KP_Q16        CONTROLLER_Q16(POSITION_KP*CONST_2PI/ENCODER_QUADRATURE_COUNT)
+/* Velocity reference bound in position mode */
+#define MAIN_MAX_VELOCITY_Q16       CONTROLLER_Q16(MAX_MOTOR_VELOCITY_RAD)
+volatile int iPositionMode = 0;
+t_TRAJECTORY_Profile tTrajectory;
+/* Velocity reference shaping, between the host reference and the PID */
+t_RAMP_Data tRamp;
+/* Filters of the measured velocity, the derivative term and the actuator command */
+/* (current reference in CONTROL_LOOP_CASCADE) */
+t_FILTER_Data tVelocityFilter, tDerivativeFilter, tActuatorFilter;
+/* Velocity and acceleration observer, and whether the controller uses it ('q' command) */
+t_OBSERVER_Data tObserver;
+volatile int iVelocitySource = VELOCITY_SOURCE;
+/* Model-based feedforward of the shaped reference, added to the PID output */
+t_FEEDFORWARD_Data tFeedforward;
 
 void main_cyclicExecuteIsr(void)
 {
+    profiler_startStage(PROFILER_STAGE_TICK);
+    /* Sample-to-actuation latency is measured from the last tick */
+    profiler_startStage(PROFILER_STAGE_LATENCY);
+
+    /* Release the tasks that are due, the control task runs here in CONTROL_MODE_ISR */
+    scheduler_tick();
     /* Set the cyclic executive flag */
     uiFlagNextPeriod = 1;
+
+    profiler_stopStage(PROFILER_STAGE_TICK);
+}
+
+/**
+ * Method name:         main_positionLoop
+ * Method description:  Position mode: advances the trajectory and sets the velocity reference from
+ *                      the trajectory velocity (feedforward) plus P on the position error
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void main_positionLoop(void)
+{
+    int64_t llVelocityQ16;
+
+    trajectory_update(&tTrajectory);
+    llVelocityQ16 = trajectory_getVelocityRadQ16(&tTrajectory) +
+            (trajectory_getPositionCount(&tTrajectory) - encoder_getMultiTurnCount())*MAIN_POSITION_KP_Q16;
+    if(llVelocityQ16 > MAIN_MAX_VELOCITY_Q16)
+        llVelocityQ16 = MAIN_MAX_VELOCITY_Q16;
+    else if(llVelocityQ16 < -MAIN_MAX_VELOCITY_Q16)
+        llVelocityQ16 = -MAIN_MAX_VELOCITY_Q16;
+
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+    iReferenceVelocityQ16 = (int32_t)llVelocityQ16;
+#else
+    dReferenceVelocity = controller_q16ToDouble((int32_t)llVelocityQ16);
+#endif
+}
+
+/**
+ * Method name:         main_controlTask
+ * Method description:  Control task: measures the motor, runs the PID and drives the motor,
+ *                      or sets the current loop reference in CONTROL_LOOP_CASCADE.
+ *                      Runs in the tick ISR when CONTROL_MODE is CONTROL_MODE_ISR
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void main_controlTask(void)
+{
+    static uint32_t uiLastSampleTime = 0;
+    static int iHasLastSample = 0;
+    uint32_t uiInterval;
+
+    /* Measure motor speed and position */
+    profiler_startStage(PROFILER_STAGE_ENCODER);
+    encoder_takeMeasurement();
+    observer_update(&tObserver, encoder_getMultiTurnCount());
+    profiler_stopStage(PROFILER_STAGE_ENCODER);
+
+    /* Filter the motor current sampled by the ADC and DMA since the last period */
+    current_update();
+
+    /* Sampling jitter: deviation of the interval between samples from the control period */
+    uiInterval = encoder_getSampleTime() - uiLastSampleTime;
+    uiLastSampleTime += uiInterval;
+    if(iHasLastSample)
+        profiler_addSample(PROFILER_STAGE_JITTER, CORE_CLOCK_MHZ*((uiInterval > CYCLIC_EXECUTIVE_PERIOD) ?
+                (uiInterval - (CYCLIC_EXECUTIVE_PERIOD)) : ((CYCLIC_EXECUTIVE_PERIOD) - uiInterval)));
+    iHasLastSample = 1;
+
+    /* The position loop runs at the control rate, ahead of the velocity PID */
+    if(iPositionMode)
+        main_positionLoop();
+
+    /* Reference shaping. The trajectory already shapes position mode, the ramp */
+    /* follows it at rest so going back to velocity mode starts from there */
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+    if(iPositionMode)
+        ramp_reset(&tRamp, iReferenceVelocityQ16);
+    iShapedVelocityQ16 = ramp_update(&tRamp, iReferenceVelocityQ16);
+#else
+    if(iPositionMode)
+        ramp_reset(&tRamp, controller_doubleToQ16(dReferenceVelocity));
+    dShapedVelocity = controller_q16ToDouble(ramp_update(&tRamp, controller_doubleToQ16(dReferenceVelocity)));
+#endif
+
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+    iSensorVelocityQ16 = filter_update(&tVelocityFilter, (VELOCITY_SOURCE_OBSERVER == iVelocitySource) ?
+            observer_getVelocityRadQ16(&tObserver) : encoder_getAngularVelocityRadQ16());
+
+    /* Execute PID calculations */
+    profiler_startStage(PROFILER_STAGE_CONTROLLER);
+    /* Feedforward of the shaped reference, off with the controller */
+    if(iShapedVelocityQ16 < pidDataQ16.iMinReference)
+        feedforward_reset(&tFeedforward, iShapedVelocityQ16);
+    else
+        feedforward_update(&tFeedforward, iShapedVelocityQ16);
+    /* Saturated with the PID output, so the anti-windup acts on what reaches the actuator */
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    controller_setFeedforwardQ16(&pidDataQ16, feedforward_getCurrentQ16(&tFeedforward));
+    iCurrentReferenceQ16 = filter_update(&tActuatorFilter, controller_PIDUpdateQ16(&pidDataQ16, iSensorVelocityQ16, iShapedVelocityQ16));
+#else
+    controller_setFeedforwardQ16(&pidDataQ16, controller_mulQ16(feedforward_getDutyPercentQ16(&tFeedforward), MAIN_ACTUATOR_UNSCALE_Q16));
+    iActuatorValueQ16 = filter_update(&tActuatorFilter,
+            controller_mulQ16(controller_PIDUpdateQ16(&pidDataQ16, iSensorVelocityQ16, iShapedVelocityQ16), MAIN_ACTUATOR_SCALE_Q16));
+#endif
+    profiler_stopStage(PROFILER_STAGE_CONTROLLER);
+
+    /* Drive motor */
+    profiler_startStage(PROFILER_STAGE_DRIVER);
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    /* The current loop drives the bridge, the back-EMF feedforward goes straight to its duty */
+    current_setReferenceQ16(iCurrentReferenceQ16);
+    current_setFeedforwardQ16(feedforward_getBackEmfDutyQ16(&tFeedforward));
+    /* Duty for telemetry, Q15 to percent in Q16.16: *100*CONTROLLER_Q16_ONE/DRIVER_Q15_ONE */
+    iActuatorValueQ16 = driver_getDriverQ15()*200;
+#else
+    /* Percent in Q16.16 to Q15: *DRIVER_Q15_ONE/(100*CONTROLLER_Q16_ONE) */
+    driver_setDriverQ15(iActuatorValueQ16/200);
+#endif
+    profiler_stopStage(PROFILER_STAGE_DRIVER);
+    profiler_stopStage(PROFILER_STAGE_LATENCY);
+
+    /* Doubles are only needed for telemetry */
+    dSensorVelocity = controller_q16ToDouble(iSensorVelocityQ16);
+    dActuatorValue = controller_q16ToDouble(iActuatorValueQ16);
+#else
+    /* The filters run in Q16.16 */
+    dSensorVelocity = controller_q16ToDouble(filter_update(&tVelocityFilter, (VELOCITY_SOURCE_OBSERVER == iVelocitySource) ?
+            observer_getVelocityRadQ16(&tObserver) : controller_doubleToQ16(encoder_getAngularVelocityRad())));
+
+    /* Execute PID calculations */
+    profiler_startStage(PROFILER_STAGE_CONTROLLER);
+    /* Feedforward of the shaped reference, off with the controller. It runs in Q16.16 */
+    if(dShapedVelocity < pidData.dMinReference)
+        feedforward_reset(&tFeedforward, controller_doubleToQ16(dShapedVelocity));
+    else
+        feedforward_update(&tFeedforward, controller_doubleToQ16(dShapedVelocity));
+    /* Saturated with the PID output, so the anti-windup acts on what reaches the actuator */
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    controller_setFeedforward(&pidData, controller_q16ToDouble(feedforward_getCurrentQ16(&tFeedforward)));
+    dCurrentReference = controller_q16ToDouble(filter_update(&tActuatorFilter,
+            controller_doubleToQ16(controller_PIDUpdate(&pidData, dSensorVelocity, dShapedVelocity))));
+#else
+    controller_setFeedforward(&pidData, controller_q16ToDouble(feedforward_getDutyPercentQ16(&tFeedforward))*MAX_MOTOR_VELOCITY_RAD/100);
+    dActuatorValue = controller_q16ToDouble(filter_update(&tActuatorFilter,
+            controller_doubleToQ16(100*controller_PIDUpdate(&pidData, dSensorVelocity, dShapedVelocity)/MAX_MOTOR_VELOCITY_RAD)));
+#endif
+    profiler_stopStage(PROFILER_STAGE_CONTROLLER);
+
+    /* Drive motor */
+    profiler_startStage(PROFILER_STAGE_DRIVER);
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    /* The current loop drives the bridge, the back-EMF feedforward goes straight to its duty */
+    current_setReferenceQ16(controller_doubleToQ16(dCurrentReference));
+    current_setFeedforwardQ16(feedforward_getBackEmfDutyQ16(&tFeedforward));
+    dActuatorValue = 100.0*driver_getDriverQ15()/DRIVER_Q15_ONE;
+#else
+    driver_setDriverQ15((int32_t)(dActuatorValue*DRIVER_Q15_ONE/100));
+#endif
+    profiler_stopStage(PROFILER_STAGE_DRIVER);
+    profiler_stopStage(PROFILER_STAGE_LATENCY);
+#endif
+    dSensorPosition = encoder_getAngularPositionDegree();
+}
+
+/**
+ * Method name:         main_hmiReceiveTask
+ * Method description:  HMI receive task: parses and applies the commands sent by the host
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void main_hmiReceiveTask(void)
+{
+    profiler_startStage(PROFILER_STAGE_HMI_RECEIVE);
+    hmi_receive();
+    profiler_stopStage(PROFILER_STAGE_HMI_RECEIVE);
+}
+
+/**
+ * Method name:         main_telemetryTask
+ * Method description:  Telemetry task: sends velocity, position and actuation to the host
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void main_telemetryTask(void)
+{
+    double dVelocity, dPosition, dActuator;
+
+    /* The control task may run in the tick ISR, take a consistent copy */
+    __disable_irq();
+    dVelocity = dSensorVelocity;
+    dPosition = dSensorPosition;
+    dActuator = dActuatorValue;
+    __enable_irq();
+
+    profiler_startStage(PROFILER_STAGE_HMI_TRANSMIT);
+    hmi_transmit(dVelocity, dPosition, dActuator);
+    profiler_stopStage(PROFILER_STAGE_HMI_TRANSMIT);
+}
+
+/**
+ * Method name:         main_idle
+ * Method description:  Sleeps until main_cyclicExecuteIsr sets the period flag, then clears it.
+ *                      Interrupts are masked between the flag test and WFI, so a tick in between
+ *                      leaves the interrupt pending and WFI returns at once instead of missing it.
+ * Input params:        n/a
+ * Output params:       n/a
+ */
+void main_idle(void)
+{
+#if (IDLE_MODE == IDLE_MODE_SPIN)
+    while(!uiFlagNextPeriod);
+#else
+    static const smc_power_mode_config_t idleConfig =
+    {
+#if (IDLE_MODE == IDLE_MODE_VLPS)
+            .powerModeName = kPowerModeVlps,
+#else
+            .powerModeName = kPowerModeWait,
+#endif
+    };
+
+    __disable_irq();
+    while(!uiFlagNextPeriod)
+    {
+        /* Executes WFI, woken by any pending interrupt */
+        SMC_HAL_SetMode(SMC, &idleConfig);
+        /* Let the pending interrupt run */
+        __enable_irq();
+        __disable_irq();
+    }
+    __enable_irq();
+#endif
+    /* Unset the cyclic executive flag */
+    uiFlagNextPeriod = 0;
 }
 
 int boardInit()
 {
     mcg_clockInit();
+    return 0;
 }
 
 int peripheralInit()
@@ -67,11 +345,38 @@ int peripheralInit()
 
     /* Device init */
     encoder_initEncoder();
+    observer_initObserver(&tObserver, encoder_getMultiTurnCount());
     driver_initDriver();
+    current_initCurrent();
+    trajectory_initTrajectory(&tTrajectory);
+    ramp_initRamp(&tRamp);
+    filter_initFilter(&tVelocityFilter, VELOCITY_FILTER);
+    filter_initFilter(&tDerivativeFilter, DERIVATIVE_FILTER);
+    filter_initFilter(&tActuatorFilter, ACTUATOR_FILTER);
+    feedforward_initFeedforward(&tFeedforward, FEEDFORWARD_SET);
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+    controller_initPIDQ16(&pidDataQ16);
+#else
     controller_initPID(&pidData);
+#endif
+
+    /* Stage timing statistics */
+    profiler_initProfiler();
+
+#if (IDLE_MODE == IDLE_MODE_VLPS)
+    /* Very low power modes must be allowed once after reset */
+    smc_power_mode_protection_config_t protection =
+    {
+            .vlpProt = true,
+    };
+    SMC_HAL_SetProtection(SMC, &protection);
+#endif
 
-    /* Cyclic executive init */
-    tc_installLptmr0(CYCLIC_EXECUTIVE_PERIOD, main_cyclicExecuteIsr);
+    /* Scheduler init, the LPTMR tick drives the task table */
+    scheduler_initScheduler();
+    tc_installLptmr0(SCHEDULER_TICK_PERIOD, main_cyclicExecuteIsr);
+    NVIC_SetPriority(LPTMR0_IRQn, SCHEDULER_TICK_IRQ_PRIORITY);
+    return 0;
 }
 
 int main(void)
@@ -81,40 +386,50 @@ int main(void)
     peripheralInit();
 
     /* Presets */
+#if (CONTROLLER_ENGINE == CONTROLLER_ENGINE_Q16)
+    controller_setKpQ16(&pidDataQ16, dKp);
+    controller_setKiQ16(&pidDataQ16, dKi);
+    controller_setKdQ16(&pidDataQ16, dKd);
+    controller_setMaxSumErrorQ16(&pidDataQ16, dMaxSumError);
+    controller_setMinReferenceQ16(&pidDataQ16, VELOCITY_MIN_REFERENCE_RAD);
+    controller_setDerivativeFilterQ16(&pidDataQ16, &tDerivativeFilter);
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    /* Current reference limit */
+    controller_setOutputLimitsQ16(&pidDataQ16, -CURRENT_LIMIT_MA/1000.0, CURRENT_LIMIT_MA/1000.0);
+#else
+    /* Full duty either way */
+    controller_setOutputLimitsQ16(&pidDataQ16, -(MAX_MOTOR_VELOCITY_RAD), MAX_MOTOR_VELOCITY_RAD);
+#endif
+#else
     controller_setKp(&pidData, dKp);
     controller_setKi(&pidData, dKi);
     controller_setKd(&pidData, dKd);
     controller_setMaxSumError(&pidData, dMaxSumError);
+    controller_setMinReference(&pidData, VELOCITY_MIN_REFERENCE_RAD);
+    controller_setDerivativeFilter(&pidData, &tDerivativeFilter);
+#if (CONTROL_LOOP == CONTROL_LOOP_CASCADE)
+    controller_setOutputLimits(&pidData, -CURRENT_LIMIT_MA/1000.0, CURRENT_LIMIT_MA/1000.0);
+#else
+    controller_setOutputLimits(&pidData, -(MAX_MOTOR_VELOCITY_RAD), MAX_MOTOR_VELOCITY_RAD);
+#endif
+#endif
 
 
     for (;;) {
         /* Blink status LED */
         PTB_BASE_PTR->PTOR = 1 << 18;
         /* Set PTB8 for timing analysis */
-        PTB_BASE_PTR->PTOR = 1 << 8;;
-
-        /* Measure motor speed and position */
-        encoder_takeMeasurement();
-
-        dSensorVelocity = encoder_getAngularVelocityRad();
-        dSensorPosition = encoder_getAngularPositionDegree();
-
-        /* Execute PID calculations */
-        dActuatorValue = 100*controller_PIDUpdate(&pidData, dSensorVelocity, dReferenceVelocity)/MAX_MOTOR_VELOCITY_RAD;
-
-        /* Drive motor */
-        driver_setDriver(dActuatorValue);
+        PTB_BASE_PTR->PTOR = 1 << 8;
+        profiler_startStage(PROFILER_STAGE_CYCLE);
 
-        /* Process serial communication */
-        hmi_receive();
-        hmi_transmit(dSensorVelocity, dSensorPosition, dActuatorValue);
+        /* Run the tasks released by the tick */
+        scheduler_runPending();
 
+        profiler_stopStage(PROFILER_STAGE_CYCLE);
         /* Clear PTB8 for timing analysis */
         PTB_BASE_PTR->PTOR = 1 << 8;
 
-        while(!uiFlagNextPeriod);
-        /* Unset the cyclic executive flag */
-        uiFlagNextPeriod = 0;
+        main_idle();
 
     }
 